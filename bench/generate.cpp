@@ -0,0 +1,284 @@
+#include <iostream>
+#include <string>
+#include <random>
+#include <algorithm>
+
+/*
+ *  Generator for synthetic COOL programs.
+ *
+ *  The generated programs are lexically, syntactically and semantically valid,
+ *  so they can be used to benchmark every phase of the front end. The size
+ *  and shape of the program is controlled by command line options.
+ */
+
+struct GeneratorOptions {
+    uint classes = 100;
+    uint methods = 10;          // methods per class
+    uint attributes = 4;        // attributes per class
+    uint depth = 4;             // maximum expression depth
+    uint comment_density = 10;  // percentage of features and expressions preceded by a comment
+    uint string_density = 10;   // percentage of expression leaves that use a string literal
+    uint seed = 1;
+};
+
+class Generator {
+    private:
+        GeneratorOptions options;
+        std::mt19937 rng;
+        std::string out;
+
+        // the class currently being generated
+        uint current_class = 0;
+
+        uint random(uint n) {
+            return std::uniform_int_distribution<uint>(0, n - 1)(rng);
+        }
+
+        bool chance(uint percent) {
+            return random(100) < percent;
+        }
+
+        std::string class_name(uint i) {
+            return "C" + std::to_string(i);
+        }
+
+        std::string attribute_name(uint cls, uint i) {
+            return "a" + std::to_string(cls) + "_" + std::to_string(i);
+        }
+
+        std::string method_name(uint cls, uint i) {
+            return "m" + std::to_string(cls) + "_" + std::to_string(i);
+        }
+
+        void indent(uint level) {
+            out.append(level * 4, ' ');
+        }
+
+        void comment(uint level) {
+            if (!chance(options.comment_density)) {
+                return;
+            }
+
+            indent(level);
+            if (chance(50)) {
+                out += "-- the quick brown fox jumps over the lazy dog " + std::to_string(random(1000)) + "\n";
+            } else {
+                out += "(* a block comment spanning\n";
+                indent(level);
+                out += "   (* with a nested comment *) two lines *)\n";
+            }
+        }
+
+        void string_literal() {
+            static const char* words[] = { "lorem", "ipsum", "dolor", "sit", "amet", "tab\\t", "newline\\n", "quote\\\"" };
+
+            out += '"';
+            uint n = 1 + random(8);
+            for (uint i = 0; i < n; ++i) {
+                out += words[random(sizeof(words) / sizeof(words[0]))];
+                out += ' ';
+            }
+            out += '"';
+        }
+
+        // leaves are integer constants, formals, attributes or string lengths
+        void leaf() {
+            if (chance(options.string_density)) {
+                out += '(';
+                string_literal();
+                out += ".length())";
+                return;
+            }
+
+            switch (random(4)) {
+                case 0:
+                    out += std::to_string(random(100000));
+                    break;
+                case 1:
+                    out += "x";
+                    break;
+                case 2:
+                    out += "y";
+                    break;
+                default:
+                    out += attribute_name(current_class, random(options.attributes));
+                    break;
+            }
+        }
+
+        // generates an expression of static type Int
+        void expression(uint depth, uint level) {
+            if (depth == 0 || chance(15)) {
+                leaf();
+                return;
+            }
+
+            switch (random(9)) {
+                case 0:
+                case 1:
+                case 2: {
+                    static const char* operators[] = { " + ", " - ", " * " };
+                    out += '(';
+                    expression(depth - 1, level);
+                    out += operators[random(3)];
+                    expression(depth - 1, level);
+                    out += ')';
+                    break;
+                }
+
+                case 3:
+                    out += "if ";
+                    expression(depth - 1, level);
+                    out += chance(50) ? " < " : " <= ";
+                    expression(depth - 1, level);
+                    out += " then ";
+                    expression(depth - 1, level);
+                    out += " else ";
+                    expression(depth - 1, level);
+                    out += " fi";
+                    break;
+
+                case 4:
+                    out += "(let z : Int <- ";
+                    expression(depth - 1, level);
+                    out += " in z + ";
+                    expression(depth - 1, level);
+                    out += ")";
+                    break;
+
+                case 5:
+                    out += "{\n";
+                    for (uint i = 0, n = 1 + random(3); i < n; ++i) {
+                        comment(level + 1);
+                        indent(level + 1);
+                        expression(depth - 1, level + 1);
+                        out += ";\n";
+                    }
+                    indent(level);
+                    out += "}";
+                    break;
+
+                case 6:
+                    out += "case ";
+                    expression(depth - 1, level);
+                    out += " of i : Int => ";
+                    expression(depth - 1, level);
+                    out += "; o : Object => ";
+                    expression(depth - 1, level);
+                    out += "; esac";
+                    break;
+
+                case 7:
+                    // methods only call methods of their own class, all of which take two integers
+                    out += method_name(current_class, random(options.methods)) + "(";
+                    expression(depth - 1, level);
+                    out += ", ";
+                    expression(depth - 1, level);
+                    out += ")";
+                    break;
+
+                default:
+                    out += "~(";
+                    expression(depth - 1, level);
+                    out += ")";
+                    break;
+            }
+        }
+
+        void class_definition(uint cls) {
+            current_class = cls;
+
+            comment(0);
+            out += "class " + class_name(cls);
+            if (cls > 0 && chance(50)) {
+                out += " inherits " + class_name(random(cls));
+            }
+            out += " {\n";
+
+            for (uint i = 0; i < options.attributes; ++i) {
+                comment(1);
+                indent(1);
+                out += attribute_name(cls, i) + " : Int <- " + std::to_string(random(1000)) + ";\n";
+            }
+
+            for (uint i = 0; i < options.methods; ++i) {
+                comment(1);
+                indent(1);
+                out += method_name(cls, i) + "(x : Int, y : Int) : Int {\n";
+                indent(2);
+                expression(options.depth, 2);
+                out += "\n";
+                indent(1);
+                out += "};\n";
+            }
+
+            out += "};\n\n";
+        }
+
+    public:
+        Generator(const GeneratorOptions& opts) : options(opts), rng(opts.seed) {}
+
+        std::string generate() {
+            for (uint i = 0; i < options.classes; ++i) {
+                class_definition(i);
+            }
+
+            out += "class Main inherits IO {\n";
+            out += "    main() : Object {\n";
+            out += "        out_string(\"done\\n\")\n";
+            out += "    };\n";
+            out += "};\n";
+
+            return out;
+        }
+};
+
+static void print_usage(int exit_code) {
+    std::cerr << "Usage: ./generate [options] > program.cl\n";
+    std::cerr << "Options:\n";
+    std::cerr << "  --classes <n>\t\t\tNumber of classes (default: 100)\n";
+    std::cerr << "  --methods <n>\t\t\tMethods per class (default: 10)\n";
+    std::cerr << "  --attributes <n>\t\tAttributes per class (default: 4)\n";
+    std::cerr << "  --depth <n>\t\t\tMaximum expression depth (default: 4)\n";
+    std::cerr << "  --comments <percent>\t\tComment density (default: 10)\n";
+    std::cerr << "  --strings <percent>\t\tString literal density (default: 10)\n";
+    std::cerr << "  --seed <n>\t\t\tRandom seed (default: 1)\n";
+    exit(exit_code);
+}
+
+int main(int argc, char *argv[]) {
+    GeneratorOptions options;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = std::string(argv[i]);
+
+        if (arg == "--help") {
+            print_usage(0);
+        } else if (i + 1 >= argc) {
+            print_usage(1);
+        }
+
+        uint value = std::stoul(argv[++i]);
+        if (arg == "--classes") {
+            options.classes = value;
+        } else if (arg == "--methods") {
+            options.methods = std::max(value, 1u);
+        } else if (arg == "--attributes") {
+            options.attributes = std::max(value, 1u);
+        } else if (arg == "--depth") {
+            options.depth = value;
+        } else if (arg == "--comments") {
+            options.comment_density = value;
+        } else if (arg == "--strings") {
+            options.string_density = value;
+        } else if (arg == "--seed") {
+            options.seed = value;
+        } else {
+            print_usage(1);
+        }
+    }
+
+    std::cout << Generator(options).generate();
+
+    return 0;
+}
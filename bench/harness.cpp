@@ -0,0 +1,134 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <chrono>
+#include <algorithm>
+#include "../src/utils/source_file.h"
+#include "../src/common/ast.h"
+#include "../src/common/ast_stats.h"
+#include "../src/common/token.h"
+#include "../src/compiler/lexer/lexer.h"
+#include "../src/compiler/parser/parser.h"
+
+/*
+ *  Front end benchmark harness.
+ *
+ *  Times the lexer, the parser and the semantic analyzer separately on a
+ *  single program. Each phase is run a number of times and the fastest run
+ *  is reported, as MB/s, tokens/s and nodes/s where they make sense.
+ *  Results are printed and appended as a JSON line to the output file.
+ */
+
+typedef std::chrono::steady_clock Clock;
+
+struct PhaseTimes {
+    double scan = 1e30;
+    double parse = 1e30;
+    double analyze = 1e30;
+};
+
+static double elapsed(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+static double rate(double amount, double time) {
+    return time > 0 ? amount / time : 0;
+}
+
+static void print_usage(int exit_code) {
+    std::cerr << "Usage: ./harness <sourcefile> [options]\n";
+    std::cerr << "Options:\n";
+    std::cerr << "  --iterations <n>\t\tNumber of runs per phase (default: 5)\n";
+    std::cerr << "  --jobs <n>\t\t\tNumber of threads for lexing (default: 1)\n";
+    std::cerr << "  --label <name>\t\tName of the workload in the results (default: sourcefile)\n";
+    std::cerr << "  --out <file>\t\t\tAppend results to this file (default: bench/results.jsonl)\n";
+    exit(exit_code);
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2 || std::string(argv[1]) == "--help") {
+        print_usage(argc < 2);
+    }
+
+    std::string sourcefile = argv[1];
+    std::string label = sourcefile;
+    std::string outfile = "bench/results.jsonl";
+    uint iterations = 5;
+    uint jobs = 1;
+
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = std::string(argv[i]);
+        if (i + 1 >= argc) {
+            print_usage(1);
+        } else if (arg == "--iterations") {
+            iterations = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--jobs") {
+            jobs = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--label") {
+            label = argv[++i];
+        } else if (arg == "--out") {
+            outfile = argv[++i];
+        } else {
+            print_usage(1);
+        }
+    }
+
+    SourceFile source(sourcefile);
+    std::string_view contents = source.get_contents();
+
+    PhaseTimes best;
+    size_t tokens = 0;
+    size_t nodes = 0;
+
+    for (uint i = 0; i < iterations; ++i) {
+        Scanner scanner;
+        Parser parser;
+
+        auto start = Clock::now();
+        Tokenstream ts = scanner.scan(contents, jobs);
+        best.scan = std::min(best.scan, elapsed(start));
+        tokens = ts.size();
+
+        start = Clock::now();
+        ProgramNode ast = parser.parse(ts);
+        best.parse = std::min(best.parse, elapsed(start));
+        nodes = AstStats(ast).get_node_count();
+
+        start = Clock::now();
+        ast.analyze();
+        best.analyze = std::min(best.analyze, elapsed(start));
+    }
+
+    double megabytes = contents.size() / (1024.0 * 1024.0);
+
+    std::cout << label << ": " << contents.size() << " bytes, " << tokens << " tokens, " << nodes << " nodes\n";
+    std::cout << "  scan\t\t" << best.scan * 1000 << " ms\t" << rate(megabytes, best.scan) << " MB/s\t"
+              << rate(tokens, best.scan) << " tokens/s\n";
+    std::cout << "  parse\t\t" << best.parse * 1000 << " ms\t" << rate(tokens, best.parse) << " tokens/s\t"
+              << rate(nodes, best.parse) << " nodes/s\n";
+    std::cout << "  analyze\t" << best.analyze * 1000 << " ms\t" << rate(nodes, best.analyze) << " nodes/s\n";
+
+    std::ofstream out(outfile, std::ios::app);
+    if (!out) {
+        std::cerr << "Unable to open " << outfile << std::endl;
+        return 1;
+    }
+
+    out << "{\"workload\": \"" << label << "\""
+        << ", \"bytes\": " << contents.size()
+        << ", \"tokens\": " << tokens
+        << ", \"nodes\": " << nodes
+        << ", \"iterations\": " << iterations
+        << ", \"jobs\": " << jobs
+        << ", \"scan\": {\"seconds\": " << best.scan
+        << ", \"mb_per_s\": " << rate(megabytes, best.scan)
+        << ", \"tokens_per_s\": " << rate(tokens, best.scan) << "}"
+        << ", \"parse\": {\"seconds\": " << best.parse
+        << ", \"tokens_per_s\": " << rate(tokens, best.parse)
+        << ", \"nodes_per_s\": " << rate(nodes, best.parse) << "}"
+        << ", \"analyze\": {\"seconds\": " << best.analyze
+        << ", \"nodes_per_s\": " << rate(nodes, best.analyze) << "}"
+        << "}" << std::endl;
+
+    return 0;
+}
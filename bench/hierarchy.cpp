@@ -0,0 +1,218 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+
+/*
+ *  Generator for COOL programs with large class hierarchies.
+ *
+ *  Every class descends from C0, which declares the methods that the other
+ *  classes override. Each class overrides some of them, adds a method of its
+ *  own, and every few levels an attribute. Method bodies dispatch on objects
+ *  whose type is the least upper bound of two classes and use case
+ *  expressions over classes from all over the hierarchy, so that both the
+ *  semantic analyzer and the code generator have to query the hierarchy.
+ *
+ *  The shape of the hierarchy is one of
+ *    wide:  a tree with a fan-out of 16, a few levels deep
+ *    deep:  chains of classes up to the maximum depth below C0
+ *    mixed: every class extends either the previous class or a random one
+ */
+
+struct HierarchyOptions {
+    std::string shape = "mixed";
+    uint classes = 1000;
+    uint max_depth = 200;
+    uint methods = 4;           // methods declared by C0
+    uint overrides = 2;         // methods of C0 overridden by every other class
+    uint attribute_period = 10; // levels between classes that declare an attribute
+    uint branches = 4;          // branches of each case expression
+    uint seed = 1;
+};
+
+class HierarchyGenerator {
+    private:
+        static constexpr uint WideFanout = 16;
+
+        HierarchyOptions options;
+        std::mt19937 rng;
+        std::string out;
+
+        std::vector<uint> parents;
+        std::vector<uint> depths;
+
+        uint random(uint n) {
+            return std::uniform_int_distribution<uint>(0, n - 1)(rng);
+        }
+
+        std::string class_name(uint i) {
+            return "C" + std::to_string(i);
+        }
+
+        std::string method_name(uint i) {
+            return "m" + std::to_string(i);
+        }
+
+        uint choose_parent(uint cls) {
+            if (options.shape == "wide") {
+                return (cls - 1) / WideFanout;
+            }
+
+            uint parent = cls - 1;
+            if (options.shape == "mixed" && random(2) == 0) {
+                parent = random(cls);
+            }
+
+            // a class that would be too deep starts a new chain below C0
+            return depths[parent] < options.max_depth ? parent : 0;
+        }
+
+        // an object whose static type is the least upper bound of two classes
+        void joined_object(uint cls) {
+            out += "(if x < 0 then new " + class_name(cls) + " else new " + class_name(random(parents.size())) + " fi)";
+        }
+
+        void case_expression(uint cls) {
+            // the branches test the class, its parent and random classes, ending with Object
+            std::vector<uint> types = { cls, parents[cls] };
+            while (types.size() < options.branches && types.size() < cls + 1) {
+                uint type = random(cls + 1);
+                if (std::find(types.begin(), types.end(), type) == types.end()) {
+                    types.push_back(type);
+                }
+            }
+            if (cls == 0) {
+                types.pop_back();
+            }
+
+            out += "case ";
+            joined_object(cls);
+            out += " of\n";
+            for (uint type : types) {
+                out += "            c : " + class_name(type) + " => c." + method_name(random(options.methods)) + "(x - 1);\n";
+            }
+            out += "            o : Object => 0;\n";
+            out += "        esac";
+        }
+
+        void method_definition(uint cls, const std::string& name) {
+            out += "    " + name + "(x : Int) : Int {\n";
+            out += "        if x <= 0 then 0 else\n";
+            out += "        ";
+            case_expression(cls);
+            out += "\n        fi\n";
+            out += "    };\n";
+        }
+
+        void class_definition(uint cls) {
+            out += "class " + class_name(cls);
+            if (cls > 0) {
+                out += " inherits " + class_name(parents[cls]);
+            }
+            out += " {\n";
+
+            if (depths[cls] % options.attribute_period == 0) {
+                out += "    a" + std::to_string(cls) + " : Int <- " + std::to_string(cls) + ";\n";
+            }
+
+            if (cls == 0) {
+                for (uint i = 0; i < options.methods; ++i) {
+                    method_definition(cls, method_name(i));
+                }
+            } else {
+                std::vector<uint> overridden;
+                while (overridden.size() < std::min(options.overrides, options.methods)) {
+                    uint method = random(options.methods);
+                    if (std::find(overridden.begin(), overridden.end(), method) == overridden.end()) {
+                        overridden.push_back(method);
+                        method_definition(cls, method_name(method));
+                    }
+                }
+            }
+
+            // a method of its own, which calls an inherited one
+            out += "    f" + std::to_string(cls) + "(x : Int) : Int { " + method_name(random(options.methods)) + "(x) + 1 };\n";
+            out += "};\n\n";
+        }
+
+    public:
+        HierarchyGenerator(const HierarchyOptions& opts) : options(opts), rng(opts.seed) {}
+
+        std::string generate() {
+            uint count = std::max(options.classes, 1u);
+            for (uint cls = 0; cls < count; ++cls) {
+                uint parent = cls > 0 ? choose_parent(cls) : 0;
+                parents.push_back(parent);
+                depths.push_back(cls > 0 ? depths[parent] + 1 : 1);
+            }
+
+            for (uint cls = 0; cls < count; ++cls) {
+                class_definition(cls);
+            }
+
+            out += "class Main inherits IO {\n";
+            out += "    main() : Object {\n";
+            out += "        out_int((new " + class_name(count - 1) + ")." + method_name(0) + "(3))\n";
+            out += "    };\n";
+            out += "};\n";
+
+            return out;
+        }
+};
+
+static void print_usage(int exit_code) {
+    std::cerr << "Usage: ./hierarchy [options] > program.cl\n";
+    std::cerr << "Options:\n";
+    std::cerr << "  --shape <shape>\t\twide, deep or mixed (default: mixed)\n";
+    std::cerr << "  --classes <n>\t\t\tNumber of classes (default: 1000)\n";
+    std::cerr << "  --max-depth <n>\t\tMaximum depth of the hierarchy (default: 200)\n";
+    std::cerr << "  --methods <n>\t\t\tMethods that can be overridden (default: 4)\n";
+    std::cerr << "  --overrides <n>\t\tMethods overridden by each class (default: 2)\n";
+    std::cerr << "  --attribute-period <n>\tLevels between attributes (default: 10)\n";
+    std::cerr << "  --branches <n>\t\tBranches of each case expression (default: 4)\n";
+    std::cerr << "  --seed <n>\t\t\tRandom seed (default: 1)\n";
+    exit(exit_code);
+}
+
+int main(int argc, char *argv[]) {
+    HierarchyOptions options;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = std::string(argv[i]);
+
+        if (arg == "--help") {
+            print_usage(0);
+        } else if (i + 1 >= argc) {
+            print_usage(1);
+        }
+
+        std::string value = argv[++i];
+        if (arg == "--shape") {
+            if (value != "wide" && value != "deep" && value != "mixed") {
+                print_usage(1);
+            }
+            options.shape = value;
+        } else if (arg == "--classes") {
+            options.classes = std::stoul(value);
+        } else if (arg == "--max-depth") {
+            options.max_depth = std::max<uint>(std::stoul(value), 1);
+        } else if (arg == "--methods") {
+            options.methods = std::max<uint>(std::stoul(value), 1);
+        } else if (arg == "--overrides") {
+            options.overrides = std::stoul(value);
+        } else if (arg == "--attribute-period") {
+            options.attribute_period = std::max<uint>(std::stoul(value), 1);
+        } else if (arg == "--branches") {
+            options.branches = std::max<uint>(std::stoul(value), 1);
+        } else if (arg == "--seed") {
+            options.seed = std::stoul(value);
+        } else {
+            print_usage(1);
+        }
+    }
+
+    std::cout << HierarchyGenerator(options).generate();
+
+    return 0;
+}
@@ -0,0 +1,264 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <algorithm>
+#include "../src/utils/phase_timer.h"
+
+/*
+ *  Scalability benchmark harness.
+ *
+ *  Compiles the same kind of program at growing sizes with --time-phases
+ *  and checks how the time of every phase grows with the number of classes.
+ *  The growth from the smallest to the largest size may not exceed that of
+ *  n log n by more than a tolerance, otherwise the harness fails. Phases
+ *  that stay below a minimum time are too noisy to judge and are skipped,
+ *  and the growth of a phase is measured from the first size at which it
+ *  takes at least that long.
+ *
+ *  Each size is compiled several times and the fastest run is kept.
+ *  Results are printed and appended as a JSON line to the output file.
+ */
+
+static constexpr size_t PhaseCount = static_cast<size_t>(Phase::Count);
+
+struct Workload {
+    uint classes = 0;
+    std::string sourcefile;
+    size_t bytes = 0;
+
+    // fastest wall time of every phase and of the whole compilation, in milliseconds
+    std::array<double, PhaseCount> phases;
+    double total = 1e30;
+};
+
+struct Growth {
+    std::string phase;
+    double ratio = 0;
+    double limit = 0;
+    bool judged = false;
+    bool ok = true;
+};
+
+static void print_usage(int exit_code) {
+    std::cerr << "Usage: ./scaling <classes>:<sourcefile>... [options]\n";
+    std::cerr << "Options:\n";
+    std::cerr << "  --compiler <path>\t\tCompiler to run (default: ./coolr)\n";
+    std::cerr << "  --iterations <n>\t\tNumber of runs per size (default: 3)\n";
+    std::cerr << "  --jobs <n>\t\t\tNumber of threads of the compiler (default: 1)\n";
+    std::cerr << "  --tolerance <x>\t\tAllowed growth beyond n log n (default: 2)\n";
+    std::cerr << "  --min-time <ms>\t\tPhases faster than this are not judged (default: 20)\n";
+    std::cerr << "  --label <name>\t\tName of the workload in the results (default: hierarchy)\n";
+    std::cerr << "  --out <file>\t\t\tAppend results to this file (default: bench/scaling.jsonl)\n";
+    exit(exit_code);
+}
+
+// the wall time of a phase in the --time-phases report, in milliseconds
+static double wall_time(const std::string& report, const std::string& name) {
+    std::string key = "\"" + name + "\":{\"wall_us\":";
+    size_t position = report.find(key);
+    if (position == std::string::npos) {
+        throw std::runtime_error("No time for " + name + " in: " + report);
+    }
+    return std::stod(report.substr(position + key.size())) / 1000;
+}
+
+static std::string run_compiler(const std::string& command) {
+    FILE* pipe = popen(command.c_str(), "r");
+    if (!pipe) {
+        throw std::runtime_error("Unable to run " + command);
+    }
+
+    std::string output;
+    char buffer[4096];
+    while (fgets(buffer, sizeof(buffer), pipe)) {
+        output += buffer;
+    }
+
+    if (pclose(pipe) != 0) {
+        throw std::runtime_error("Compilation failed: " + command + "\n" + output);
+    }
+
+    size_t report = output.find("{\"phases\":");
+    if (report == std::string::npos) {
+        throw std::runtime_error("No --time-phases report from " + command);
+    }
+    return output.substr(report, output.find('\n', report) - report);
+}
+
+static double n_log_n(double n) {
+    return n * std::log2(std::max(n, 2.0));
+}
+
+static Growth check_growth(const std::vector<Workload>& workloads, const std::string& phase,
+                           const std::vector<double>& times, double tolerance, double min_time) {
+    Growth growth;
+    growth.phase = phase;
+
+    size_t first = 0;
+    while (first < times.size() && times[first] < min_time) {
+        first++;
+    }
+
+    // a phase needs two sizes that are slow enough to be measured
+    size_t last = times.size() - 1;
+    if (first >= last) {
+        return growth;
+    }
+
+    growth.judged = true;
+    growth.ratio = times[last] / times[first];
+    growth.limit = tolerance * n_log_n(workloads[last].classes) / n_log_n(workloads[first].classes);
+    growth.ok = growth.ratio <= growth.limit;
+    return growth;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2 || std::string(argv[1]) == "--help") {
+        print_usage(argc < 2);
+    }
+
+    std::vector<Workload> workloads;
+    std::string compiler = "./coolr";
+    std::string label = "hierarchy";
+    std::string outfile = "bench/scaling.jsonl";
+    uint iterations = 3;
+    uint jobs = 1;
+    double tolerance = 2;
+    double min_time = 20;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = std::string(argv[i]);
+        if (arg.rfind("--", 0) != 0) {
+            // a workload is given as the number of classes and the program
+            size_t colon = arg.find(':');
+            if (colon == std::string::npos) {
+                print_usage(1);
+            }
+            Workload workload;
+            workload.classes = std::stoul(arg.substr(0, colon));
+            workload.sourcefile = arg.substr(colon + 1);
+            workloads.push_back(workload);
+        } else if (i + 1 >= argc) {
+            print_usage(1);
+        } else if (arg == "--compiler") {
+            compiler = argv[++i];
+        } else if (arg == "--iterations") {
+            iterations = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--jobs") {
+            jobs = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--tolerance") {
+            tolerance = std::stod(argv[++i]);
+        } else if (arg == "--min-time") {
+            min_time = std::stod(argv[++i]);
+        } else if (arg == "--label") {
+            label = argv[++i];
+        } else if (arg == "--out") {
+            outfile = argv[++i];
+        } else {
+            print_usage(1);
+        }
+    }
+
+    if (workloads.size() < 2) {
+        std::cerr << "At least two sizes are needed to measure growth" << std::endl;
+        return 1;
+    }
+
+    std::sort(workloads.begin(), workloads.end(), [](const Workload& a, const Workload& b) {
+        return a.classes < b.classes;
+    });
+
+    std::cout << label << ":\n";
+    for (Workload& workload : workloads) {
+        workload.phases.fill(1e30);
+        workload.bytes = std::ifstream(workload.sourcefile, std::ios::binary | std::ios::ate).tellg();
+
+        // the assembly is written next to the program, so that writing it is measured too
+        std::string command = compiler + " " + workload.sourcefile + " --no-cache --time-phases --jobs " +
+                              std::to_string(jobs) + " --out " + workload.sourcefile + ".S 2>&1 >/dev/null";
+
+        try {
+            for (uint i = 0; i < iterations; ++i) {
+                std::string report = run_compiler(command);
+                for (size_t phase = 0; phase < PhaseCount; ++phase) {
+                    double time = wall_time(report, PhaseTimer::get_phase_name(static_cast<Phase>(phase)));
+                    workload.phases[phase] = std::min(workload.phases[phase], time);
+                }
+                workload.total = std::min(workload.total, wall_time(report, "total"));
+            }
+        } catch (const std::exception& error) {
+            std::cerr << error.what() << std::endl;
+            return 1;
+        }
+
+        std::cout << "  " << workload.classes << " classes, " << workload.bytes << " bytes\t" << workload.total << " ms\n";
+    }
+
+    std::vector<Growth> growths;
+    for (size_t phase = 0; phase < PhaseCount; ++phase) {
+        std::vector<double> times;
+        for (const Workload& workload : workloads) {
+            times.push_back(workload.phases[phase]);
+        }
+        growths.push_back(check_growth(workloads, PhaseTimer::get_phase_name(static_cast<Phase>(phase)), times, tolerance, min_time));
+    }
+
+    std::vector<double> totals;
+    for (const Workload& workload : workloads) {
+        totals.push_back(workload.total);
+    }
+    growths.push_back(check_growth(workloads, "total", totals, tolerance, min_time));
+
+    bool ok = true;
+    std::cout << "  growth from " << workloads.front().classes << " to " << workloads.back().classes << " classes:\n";
+    for (const Growth& growth : growths) {
+        std::cout << "    " << std::left << std::setw(12) << growth.phase << std::right;
+        if (growth.judged) {
+            std::cout << "x" << growth.ratio << "\t(limit x" << growth.limit << ")\t" << (growth.ok ? "ok" : "FAILED") << "\n";
+        } else {
+            std::cout << "too fast to judge\n";
+        }
+        ok = ok && growth.ok;
+    }
+
+    std::ofstream out(outfile, std::ios::app);
+    if (!out) {
+        std::cerr << "Unable to open " << outfile << std::endl;
+        return 1;
+    }
+
+    out << "{\"workload\": \"" << label << "\""
+        << ", \"iterations\": " << iterations
+        << ", \"jobs\": " << jobs
+        << ", \"sizes\": [";
+    for (size_t i = 0; i < workloads.size(); ++i) {
+        const Workload& workload = workloads[i];
+        out << (i > 0 ? ", " : "") << "{\"classes\": " << workload.classes
+            << ", \"bytes\": " << workload.bytes
+            << ", \"total_ms\": " << workload.total
+            << ", \"phases_ms\": {";
+        for (size_t phase = 0; phase < PhaseCount; ++phase) {
+            out << (phase > 0 ? ", " : "") << "\"" << PhaseTimer::get_phase_name(static_cast<Phase>(phase)) << "\": " << workload.phases[phase];
+        }
+        out << "}}";
+    }
+    out << "], \"growth\": {";
+    for (size_t i = 0; i < growths.size(); ++i) {
+        const Growth& growth = growths[i];
+        out << (i > 0 ? ", " : "") << "\"" << growth.phase << "\": ";
+        if (growth.judged) {
+            out << "{\"ratio\": " << growth.ratio << ", \"limit\": " << growth.limit << ", \"ok\": " << (growth.ok ? "true" : "false") << "}";
+        } else {
+            out << "null";
+        }
+    }
+    out << "}, \"ok\": " << (ok ? "true" : "false") << "}" << std::endl;
+
+    return ok ? 0 : 1;
+}
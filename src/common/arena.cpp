@@ -0,0 +1,38 @@
+#include "arena.h"
+
+/*
+ *  Block management for the bump allocator.
+ */
+
+Arena::~Arena() {
+    // later nodes may refer to earlier ones, so tear down newest first
+    for (auto it = destructors.rbegin(); it != destructors.rend(); ++it) {
+        it->destroy(it->object);
+    }
+}
+
+void* Arena::allocate_block(size_t size, size_t alignment) {
+    // objects larger than a block get a block of their own
+    size_t capacity = std::max(block_size, size + alignment);
+
+    blocks.emplace_back(new char[capacity]);
+    cursor = blocks.back().get();
+    limit = cursor + capacity;
+
+    return allocate(size, alignment);
+}
+
+void Arena::adopt(Arena& other) {
+    // allocation continues in the current block, the
+    // blocks of the other arena are only kept alive
+    for (std::unique_ptr<char[]>& block : other.blocks) {
+        blocks.push_back(std::move(block));
+    }
+    destructors.insert(destructors.end(), other.destructors.begin(), other.destructors.end());
+    bytes_allocated += other.bytes_allocated;
+
+    other.blocks.clear();
+    other.destructors.clear();
+    other.cursor = other.limit = nullptr;
+    other.bytes_allocated = 0;
+}
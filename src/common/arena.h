@@ -0,0 +1,99 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <utility>
+#include <type_traits>
+#include <algorithm>
+
+/*
+ *  Bump allocator for AST nodes.
+ *
+ *  Objects are placed one after another in large blocks and are never
+ *  freed individually. When the arena is destroyed, the destructors of
+ *  objects that need one are run in reverse order of creation, and all
+ *  blocks are released at once.
+ */
+
+class Arena {
+    private:
+        struct Destructor {
+            void* object;
+            void (*destroy)(void*);
+        };
+
+        std::vector<std::unique_ptr<char[]>> blocks;
+        std::vector<Destructor> destructors;
+
+        // free space in the current block
+        char* cursor = nullptr;
+        char* limit = nullptr;
+
+        size_t block_size;
+        size_t bytes_allocated = 0;
+
+        void* allocate_block(size_t, size_t);
+
+        template <typename T>
+        static void destroy(void* object) {
+            static_cast<T*>(object)->~T();
+        }
+
+    public:
+        static constexpr size_t DefaultBlockSize = 64 * 1024;
+
+        explicit Arena(size_t block_size = DefaultBlockSize) : block_size(block_size) {}
+        ~Arena();
+
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+
+        void* allocate(size_t size, size_t alignment) {
+            uintptr_t address = (reinterpret_cast<uintptr_t>(cursor) + alignment - 1) & ~(alignment - 1);
+            char* start = reinterpret_cast<char*>(address);
+
+            if (!cursor || start + size > limit) {
+                return allocate_block(size, alignment);
+            }
+
+            cursor = start + size;
+            bytes_allocated += size;
+            return start;
+        }
+
+        template <typename T, typename... Args>
+        T* make(Args&&... args) {
+            T* object = new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+
+            // nodes that only hold symbols and pointers need no cleanup
+            if constexpr (!std::is_trivially_destructible_v<T>) {
+                destructors.push_back({ object, &destroy<T> });
+            }
+
+            return object;
+        }
+
+        // copies an array of trivially copyable values into the arena
+        template <typename T>
+        T* copy(const T* items, size_t count) {
+            static_assert(std::is_trivially_copyable_v<T>);
+            T* result = static_cast<T*>(allocate(std::max<size_t>(count, 1) * sizeof(T), alignof(T)));
+            std::copy(items, items + count, result);
+            return result;
+        }
+
+        // takes over the objects of another arena, which is left empty
+        void adopt(Arena&);
+
+        size_t get_bytes_allocated() const {
+            return bytes_allocated;
+        }
+
+        size_t get_block_count() const {
+            return blocks.size();
+        }
+};
+
+#endif
@@ -5,226 +5,275 @@
  *
  *  The display methods follow the syntax used in the Stanford course
  *  so that this compiler can be tested using the grading tests from the course.
+ *  Line numbers are shown relative to the file the node comes from.
+ *  All dumps go through the buffered writer for standard output.
  */
 
-void ProgramNode::dump(uint spaces) {
-    std::cout << std::string(spaces, ' ') << '#' << get_line_number() << std::endl;
-    std::cout << std::string(spaces, ' ') << "_program" << std::endl;
+static Writer& out = Writer::standard_output();
+
+// short name of a node type, as in the dumps
+const char* get_node_type_name(NodeType type) {
+    switch (type) {
+        case NodeType::ProgramNodeType: return "program";
+        case NodeType::ClassNodeType: return "class";
+        case NodeType::AttributeNodeType: return "attr";
+        case NodeType::MethodNodeType: return "method";
+        case NodeType::FormalsNodeType: return "formals";
+        case NodeType::FormalNodeType: return "formal";
+        case NodeType::CaseBranchType: return "branch";
+        case NodeType::ExpressionNodeType: return "expr";
+        case NodeType::NoExpressionNodeType: return "no_expr";
+        case NodeType::IntNodeType: return "int";
+        case NodeType::StringNodeType: return "string";
+        case NodeType::BoolNodeType: return "bool";
+        case NodeType::IdentifierNodeType: return "object";
+        case NodeType::AssignmentNodeType: return "assign";
+        case NodeType::NewNodeType: return "new";
+        case NodeType::IsvoidNodeType: return "isvoid";
+        case NodeType::NegNodeType: return "neg";
+        case NodeType::ComplementNodeType: return "comp";
+        case NodeType::PlusNodeType: return "plus";
+        case NodeType::MinusNodeType: return "sub";
+        case NodeType::MultiplicationNodeType: return "mul";
+        case NodeType::DivisionNodeType: return "divide";
+        case NodeType::LTNodeType: return "lt";
+        case NodeType::LTENodeType: return "leq";
+        case NodeType::EQNodeType: return "eq";
+        case NodeType::ConditionalNodeType: return "cond";
+        case NodeType::WhileNodeType: return "loop";
+        case NodeType::BlockNodeType: return "block";
+        case NodeType::LetNodeType: return "let";
+        case NodeType::LetInitializerType: return "let_init";
+        case NodeType::CaseNodeType: return "typcase";
+        case NodeType::DispatchNodeType: return "dispatch";
+        case NodeType::StaticDispatchNodeType: return "static_dispatch";
+        default: return "unknown";
+    }
+}
+
+void Node::dump(uint spaces) {
+    // children are dumped through here, so deep nesting moves to new stack segments
+    StackSegments::nested([&] { dump_node(spaces); });
+}
+
+void ProgramNode::dump_node(uint spaces) {
+    out.indent(spaces) << '#' << SourceMap::local_line(get_line_number()) << '\n';
+    out.indent(spaces) << "_program" << '\n';
     for (ClassNode* cls : get_classes()) {
         cls->dump(spaces + 2);
     }
 }
 
-void ClassNode::dump(uint spaces) {
-    std::cout << std::string(spaces, ' ') << '#' << get_line_number() << std::endl;
-    std::cout << std::string(spaces, ' ') << "_class" << std::endl;
-    std::cout << std::string(spaces + 2, ' ') << get_name() << std::endl;
-    std::cout << std::string(spaces + 2, ' ') << get_base_class() << std::endl;
+void ClassNode::dump_node(uint spaces) {
+    out.indent(spaces) << '#' << SourceMap::local_line(get_line_number()) << '\n';
+    out.indent(spaces) << "_class" << '\n';
+    out.indent(spaces + 2) << get_name() << '\n';
+    out.indent(spaces + 2) << get_base_class() << '\n';
     
-    std::cout << std::string(spaces + 2, ' ') << '(' << std::endl;
+    out.indent(spaces + 2) << '(' << '\n';
 
     for (FeatureNode* feature : get_features()) {
         feature->dump(spaces + 2);
     }
 
-    std::cout << std::string(spaces + 2, ' ') << ')' << std::endl;
+    out.indent(spaces + 2) << ')' << '\n';
 }
 
-void AttributeNode::dump(uint spaces) {
-    std::cout << std::string(spaces, ' ') << '#' << get_line_number() << std::endl;
-    std::cout << std::string(spaces, ' ') << "_attr" << std::endl; 
-    std::cout << std::string(spaces + 2, ' ') << get_name() << std::endl;
-    std::cout << std::string(spaces + 2, ' ') << get_type() << std::endl;
+void AttributeNode::dump_node(uint spaces) {
+    out.indent(spaces) << '#' << SourceMap::local_line(get_line_number()) << '\n';
+    out.indent(spaces) << "_attr" << '\n'; 
+    out.indent(spaces + 2) << get_name() << '\n';
+    out.indent(spaces + 2) << get_type() << '\n';
     get_expr()->dump(spaces + 2);
 }
 
-void MethodNode::dump(uint spaces) {
-    std::cout << std::string(spaces, ' ') << '#' << get_line_number() << std::endl;
-    std::cout << std::string(spaces, ' ') << "_method" << std::endl;
-    std::cout << std::string(spaces + 2, ' ') << get_name() << std::endl;
+void MethodNode::dump_node(uint spaces) {
+    out.indent(spaces) << '#' << SourceMap::local_line(get_line_number()) << '\n';
+    out.indent(spaces) << "_method" << '\n';
+    out.indent(spaces + 2) << get_name() << '\n';
     get_formals()->dump(spaces + 2);
-    std::cout << std::string(spaces + 2, ' ') << get_type() << std::endl;
+    out.indent(spaces + 2) << get_type() << '\n';
     get_expr()->dump(spaces + 2);
 }
 
-void FormalsNode::dump(uint spaces) {
+void FormalsNode::dump_node(uint spaces) {
     for (FormalNode* formal : get_formals()) {
         formal->dump(spaces);
     }
 }
 
-void FormalNode::dump(uint spaces) {
-    std::cout << std::string(spaces, ' ') << '#' << get_line_number() << std::endl;
-    std::cout << std::string(spaces, ' ') << "_formal" << std::endl;
-    std::cout << std::string(spaces + 2, ' ') << get_name() << std::endl; 
-    std::cout << std::string(spaces + 2, ' ') << get_type() << std::endl; 
+void FormalNode::dump_node(uint spaces) {
+    out.indent(spaces) << '#' << SourceMap::local_line(get_line_number()) << '\n';
+    out.indent(spaces) << "_formal" << '\n';
+    out.indent(spaces + 2) << get_name() << '\n'; 
+    out.indent(spaces + 2) << get_type() << '\n'; 
 }
 
-void NoExpressionNode::dump(uint spaces) {
-    std::cout << std::string(spaces, ' ') << '#' << get_line_number() << std::endl;
-    std::cout << std::string(spaces, ' ') << "_no_expr" << std::endl;
-    std::cout << std::string(spaces, ' ') << ": " << get_checked_type() << std::endl;
+void NoExpressionNode::dump_node(uint spaces) {
+    out.indent(spaces) << '#' << SourceMap::local_line(get_line_number()) << '\n';
+    out.indent(spaces) << "_no_expr" << '\n';
+    out.indent(spaces) << ": " << get_checked_type() << '\n';
 }
 
-void IntNode::dump(uint spaces) {
-    std::cout << std::string(spaces, ' ') << '#' << get_line_number() << std::endl;
-    std::cout << std::string(spaces, ' ') << "_int" << std::endl; 
-    std::cout << std::string(spaces + 2, ' ') << get_value() << std::endl; 
-    std::cout << std::string(spaces, ' ') << ": " << get_checked_type() << std::endl;
+void IntNode::dump_node(uint spaces) {
+    out.indent(spaces) << '#' << SourceMap::local_line(get_line_number()) << '\n';
+    out.indent(spaces) << "_int" << '\n'; 
+    out.indent(spaces + 2) << get_value() << '\n'; 
+    out.indent(spaces) << ": " << get_checked_type() << '\n';
 }
 
-void StringNode::dump(uint spaces) {
-    std::cout << std::string(spaces, ' ') << '#' << get_line_number() << std::endl;
-    std::cout << std::string(spaces, ' ') << "_string" << std::endl;
-    std::cout << std::string(spaces + 2, ' ') << get_pretty_string(get_value()) << std::endl;
-    std::cout << std::string(spaces, ' ') << ": " << get_checked_type() << std::endl;
+void StringNode::dump_node(uint spaces) {
+    out.indent(spaces) << '#' << SourceMap::local_line(get_line_number()) << '\n';
+    out.indent(spaces) << "_string" << '\n';
+    out.indent(spaces + 2) << get_pretty_string(get_value()) << '\n';
+    out.indent(spaces) << ": " << get_checked_type() << '\n';
 }
 
-void BoolNode::dump(uint spaces) {
-    std::cout << std::string(spaces, ' ') << '#' << get_line_number() << std::endl;
-    std::cout << std::string(spaces, ' ') << "_bool" << std::endl;
-    std::cout << std::string(spaces + 2, ' ') << get_value() << std::endl;
-    std::cout << std::string(spaces, ' ') << ": " << get_checked_type() << std::endl;
+void BoolNode::dump_node(uint spaces) {
+    out.indent(spaces) << '#' << SourceMap::local_line(get_line_number()) << '\n';
+    out.indent(spaces) << "_bool" << '\n';
+    out.indent(spaces + 2) << get_value() << '\n';
+    out.indent(spaces) << ": " << get_checked_type() << '\n';
 }
 
-void IdentifierNode::dump(uint spaces) {
-    std::cout << std::string(spaces, ' ') << '#' << get_line_number() << std::endl;
-    std::cout << std::string(spaces, ' ') << "_object" << std::endl;
-    std::cout << std::string(spaces + 2, ' ') << get_name() << std::endl;
-    std::cout << std::string(spaces, ' ') << ": " << get_checked_type() << std::endl;
+void IdentifierNode::dump_node(uint spaces) {
+    out.indent(spaces) << '#' << SourceMap::local_line(get_line_number()) << '\n';
+    out.indent(spaces) << "_object" << '\n';
+    out.indent(spaces + 2) << get_name() << '\n';
+    out.indent(spaces) << ": " << get_checked_type() << '\n';
 }
 
-void AssignmentNode::dump(uint spaces) {
-    std::cout << std::string(spaces, ' ') << '#' << get_line_number() << std::endl;
-    std::cout << std::string(spaces, ' ') << "_assign" << std::endl;
-    std::cout << std::string(spaces + 2, ' ') << get_name() << std::endl;
+void AssignmentNode::dump_node(uint spaces) {
+    out.indent(spaces) << '#' << SourceMap::local_line(get_line_number()) << '\n';
+    out.indent(spaces) << "_assign" << '\n';
+    out.indent(spaces + 2) << get_name() << '\n';
     get_expr()->dump(spaces + 2);
-    std::cout << std::string(spaces, ' ') << ": " << get_checked_type() << std::endl;
+    out.indent(spaces) << ": " << get_checked_type() << '\n';
 }
 
-void NewNode::dump(uint spaces) {
-    std::cout << std::string(spaces, ' ') << '#' << get_line_number() << std::endl;
-    std::cout << std::string(spaces, ' ') << "_new" << std::endl;
-    std::cout << std::string(spaces + 2, ' ') << get_type() << std::endl;
-    std::cout << std::string(spaces, ' ') << ": " << get_checked_type() << std::endl;
+void NewNode::dump_node(uint spaces) {
+    out.indent(spaces) << '#' << SourceMap::local_line(get_line_number()) << '\n';
+    out.indent(spaces) << "_new" << '\n';
+    out.indent(spaces + 2) << get_type() << '\n';
+    out.indent(spaces) << ": " << get_checked_type() << '\n';
 }
 
-void IsvoidNode::dump(uint spaces) {
-    std::cout << std::string(spaces, ' ') << '#' << get_line_number() << std::endl;
-    std::cout << std::string(spaces, ' ') << "_isvoid" << std::endl;
+void IsvoidNode::dump_node(uint spaces) {
+    out.indent(spaces) << '#' << SourceMap::local_line(get_line_number()) << '\n';
+    out.indent(spaces) << "_isvoid" << '\n';
     get_expr()->dump(spaces + 2);
-    std::cout << std::string(spaces, ' ') << ": " << get_checked_type() << std::endl;
+    out.indent(spaces) << ": " << get_checked_type() << '\n';
 }
 
-void PlusNode::dump(uint spaces) {
-    std::cout << std::string(spaces, ' ') << '#' << get_line_number() << std::endl;
-    std::cout << std::string(spaces, ' ') << "_plus" << std::endl;
+void PlusNode::dump_node(uint spaces) {
+    out.indent(spaces) << '#' << SourceMap::local_line(get_line_number()) << '\n';
+    out.indent(spaces) << "_plus" << '\n';
     get_first()->dump(spaces + 2);
     get_second()->dump(spaces + 2);
-    std::cout << std::string(spaces, ' ') << ": " << get_checked_type() << std::endl;
+    out.indent(spaces) << ": " << get_checked_type() << '\n';
 }
 
-void MinusNode::dump(uint spaces) {
-    std::cout << std::string(spaces, ' ') << '#' << get_line_number() << std::endl;
-    std::cout << std::string(spaces, ' ') << "_sub" << std::endl;
+void MinusNode::dump_node(uint spaces) {
+    out.indent(spaces) << '#' << SourceMap::local_line(get_line_number()) << '\n';
+    out.indent(spaces) << "_sub" << '\n';
     get_first()->dump(spaces + 2);
     get_second()->dump(spaces + 2);
-    std::cout << std::string(spaces, ' ') << ": " << get_checked_type() << std::endl;
+    out.indent(spaces) << ": " << get_checked_type() << '\n';
 }
 
-void MultiplicationNode::dump(uint spaces) {
-    std::cout << std::string(spaces, ' ') << '#' << get_line_number() << std::endl;
-    std::cout << std::string(spaces, ' ') << "_mul" << std::endl;
+void MultiplicationNode::dump_node(uint spaces) {
+    out.indent(spaces) << '#' << SourceMap::local_line(get_line_number()) << '\n';
+    out.indent(spaces) << "_mul" << '\n';
     get_first()->dump(spaces + 2);
     get_second()->dump(spaces + 2);
-    std::cout << std::string(spaces, ' ') << ": " << get_checked_type() << std::endl;
+    out.indent(spaces) << ": " << get_checked_type() << '\n';
 }
 
-void DivisionNode::dump(uint spaces) {
-    std::cout << std::string(spaces, ' ') << '#' << get_line_number() << std::endl;
-    std::cout << std::string(spaces, ' ') << "_divide" << std::endl;
+void DivisionNode::dump_node(uint spaces) {
+    out.indent(spaces) << '#' << SourceMap::local_line(get_line_number()) << '\n';
+    out.indent(spaces) << "_divide" << '\n';
     get_first()->dump(spaces + 2);
     get_second()->dump(spaces + 2);
-    std::cout << std::string(spaces, ' ') << ": " << get_checked_type() << std::endl;
+    out.indent(spaces) << ": " << get_checked_type() << '\n';
 }
 
-void LTNode::dump(uint spaces) {
-    std::cout << std::string(spaces, ' ') << '#' << get_line_number() << std::endl;
-    std::cout << std::string(spaces, ' ') << "_lt" << std::endl;
+void LTNode::dump_node(uint spaces) {
+    out.indent(spaces) << '#' << SourceMap::local_line(get_line_number()) << '\n';
+    out.indent(spaces) << "_lt" << '\n';
     get_first()->dump(spaces + 2);
     get_second()->dump(spaces + 2);
-    std::cout << std::string(spaces, ' ') << ": " << get_checked_type() << std::endl;
+    out.indent(spaces) << ": " << get_checked_type() << '\n';
 }
 
-void LTENode::dump(uint spaces) {
-    std::cout << std::string(spaces, ' ') << '#' << get_line_number() << std::endl;
-    std::cout << std::string(spaces, ' ') << "_leq" << std::endl;
+void LTENode::dump_node(uint spaces) {
+    out.indent(spaces) << '#' << SourceMap::local_line(get_line_number()) << '\n';
+    out.indent(spaces) << "_leq" << '\n';
     get_first()->dump(spaces + 2);
     get_second()->dump(spaces + 2);
-    std::cout << std::string(spaces, ' ') << ": " << get_checked_type() << std::endl;
+    out.indent(spaces) << ": " << get_checked_type() << '\n';
 }
 
-void EQNode::dump(uint spaces) {
-    std::cout << std::string(spaces, ' ') << '#' << get_line_number() << std::endl;
-    std::cout << std::string(spaces, ' ') << "_eq" << std::endl;
+void EQNode::dump_node(uint spaces) {
+    out.indent(spaces) << '#' << SourceMap::local_line(get_line_number()) << '\n';
+    out.indent(spaces) << "_eq" << '\n';
     get_first()->dump(spaces + 2);
     get_second()->dump(spaces + 2);
-    std::cout << std::string(spaces, ' ') << ": " << get_checked_type() << std::endl;
+    out.indent(spaces) << ": " << get_checked_type() << '\n';
 }
 
-void NegNode::dump(uint spaces) {
-    std::cout << std::string(spaces, ' ') << '#' << get_line_number() << std::endl;
-    std::cout << std::string(spaces, ' ') << "_neg" << std::endl;
+void NegNode::dump_node(uint spaces) {
+    out.indent(spaces) << '#' << SourceMap::local_line(get_line_number()) << '\n';
+    out.indent(spaces) << "_neg" << '\n';
     get_expr()->dump(spaces + 2);
-    std::cout << std::string(spaces, ' ') << ": " << get_checked_type() << std::endl;
+    out.indent(spaces) << ": " << get_checked_type() << '\n';
 }
 
-void ComplementNode::dump(uint spaces) {
-    std::cout << std::string(spaces, ' ') << '#' << get_line_number() << std::endl;
-    std::cout << std::string(spaces, ' ') << "_comp" << std::endl;
+void ComplementNode::dump_node(uint spaces) {
+    out.indent(spaces) << '#' << SourceMap::local_line(get_line_number()) << '\n';
+    out.indent(spaces) << "_comp" << '\n';
     get_expr()->dump(spaces + 2);
-    std::cout << std::string(spaces, ' ') << ": " << get_checked_type() << std::endl;
+    out.indent(spaces) << ": " << get_checked_type() << '\n';
 }
 
-void ConditionalNode::dump(uint spaces) {
-    std::cout << std::string(spaces, ' ') << '#' << get_line_number() << std::endl;
-    std::cout << std::string(spaces, ' ') << "_cond" << std::endl;
+void ConditionalNode::dump_node(uint spaces) {
+    out.indent(spaces) << '#' << SourceMap::local_line(get_line_number()) << '\n';
+    out.indent(spaces) << "_cond" << '\n';
     get_predicate()->dump(spaces + 2);
     get_then()->dump(spaces + 2);
     get_else()->dump(spaces + 2);
-    std::cout << std::string(spaces, ' ') << ": " << get_checked_type() << std::endl;
+    out.indent(spaces) << ": " << get_checked_type() << '\n';
 }
 
-void WhileNode::dump(uint spaces) {
-    std::cout << std::string(spaces, ' ') << '#' << get_line_number() << std::endl;
-    std::cout << std::string(spaces, ' ') << "_loop" << std::endl;
+void WhileNode::dump_node(uint spaces) {
+    out.indent(spaces) << '#' << SourceMap::local_line(get_line_number()) << '\n';
+    out.indent(spaces) << "_loop" << '\n';
     get_predicate()->dump(spaces + 2);
     get_body()->dump(spaces + 2);
-    std::cout << std::string(spaces, ' ') << ": " << get_checked_type() << std::endl;
+    out.indent(spaces) << ": " << get_checked_type() << '\n';
 }
 
-void BlockNode::dump(uint spaces) {
-    std::cout << std::string(spaces, ' ') << '#' << get_line_number() << std::endl;
-    std::cout << std::string(spaces, ' ') << "_block" << std::endl;
+void BlockNode::dump_node(uint spaces) {
+    out.indent(spaces) << '#' << SourceMap::local_line(get_line_number()) << '\n';
+    out.indent(spaces) << "_block" << '\n';
     for (ExpressionNode* expr : get_expressions()) {
         expr->dump(spaces + 2);
     }
-    std::cout << std::string(spaces, ' ') << ": " << get_checked_type() << std::endl;
+    out.indent(spaces) << ": " << get_checked_type() << '\n';
 }
 
-void LetNode::dump(uint spaces) {
+void LetNode::dump_node(uint spaces) {
     // the unit tests from stanford represent let cases with
     // multiple initializers in a kind of weird way -
     // all initializers after the first one are written as a nested let expression
     // - that's why this function is so complicated
-    std::cout << std::string(spaces, ' ') << '#' << get_line_number() << std::endl;
-    std::cout << std::string(spaces, ' ') << "_let" << std::endl;
-    std::cout << std::string(spaces + 2, ' ') << get_initializers().front()->get_name() << std::endl;
-    std::cout << std::string(spaces + 2, ' ') << get_initializers().front()->get_type() << std::endl;
+    out.indent(spaces) << '#' << SourceMap::local_line(get_line_number()) << '\n';
+    out.indent(spaces) << "_let" << '\n';
+    out.indent(spaces + 2) << get_initializers().front()->get_name() << '\n';
+    out.indent(spaces + 2) << get_initializers().front()->get_type() << '\n';
     get_initializers().front()->get_expr()->dump(spaces + 2);
 
     uint tmp_space = 2;
-    std::vector<LetInitializerNode*> initializers = get_initializers();
+    NodeList<LetInitializerNode*> initializers = get_initializers();
     for (size_t i = 1; i < initializers.size(); ++i) {
         initializers[i]->dump(spaces + tmp_space);
         tmp_space += 2;
@@ -234,65 +283,65 @@ void LetNode::dump(uint spaces) {
 
     for (size_t i = initializers.size() - 1; i > 0; --i) {
         tmp_space -= 2;
-        std::cout << std::string(spaces + tmp_space, ' ') << ": " << initializers[i]->get_checked_type() << std::endl;
+        out.indent(spaces + tmp_space) << ": " << initializers[i]->get_checked_type() << '\n';
     }
 
-    std::cout << std::string(spaces, ' ') << ": " << get_checked_type() << std::endl;
+    out.indent(spaces) << ": " << get_checked_type() << '\n';
 }
 
-void LetInitializerNode::dump(uint spaces) {
-    std::cout << std::string(spaces, ' ') << '#' << get_line_number() << std::endl;
-    std::cout << std::string(spaces, ' ') << "_let" << std::endl;
-    std::cout << std::string(spaces + 2, ' ') << get_name() << std::endl;
-    std::cout << std::string(spaces + 2, ' ') << get_type() << std::endl;
+void LetInitializerNode::dump_node(uint spaces) {
+    out.indent(spaces) << '#' << SourceMap::local_line(get_line_number()) << '\n';
+    out.indent(spaces) << "_let" << '\n';
+    out.indent(spaces + 2) << get_name() << '\n';
+    out.indent(spaces + 2) << get_type() << '\n';
     get_expr()->dump(spaces + 2);
 }
 
-void CaseNode::dump(uint spaces) {
-    std::cout << std::string(spaces, ' ') << '#' << get_line_number() << std::endl;
-    std::cout << std::string(spaces, ' ') << "_typcase" << std::endl;
+void CaseNode::dump_node(uint spaces) {
+    out.indent(spaces) << '#' << SourceMap::local_line(get_line_number()) << '\n';
+    out.indent(spaces) << "_typcase" << '\n';
     get_target()->dump(spaces + 2);
     for (CaseBranchNode* branch : get_branches()) {
         branch->dump(spaces + 2);
     }
-    std::cout << std::string(spaces, ' ') << ": " << get_checked_type() << std::endl;
+    out.indent(spaces) << ": " << get_checked_type() << '\n';
 }
 
-void CaseBranchNode::dump(uint spaces) {
-    std::cout << std::string(spaces, ' ') << '#' << get_line_number() << std::endl;
-    std::cout << std::string(spaces, ' ') << "_branch" << std::endl;
-    std::cout << std::string(spaces + 2, ' ') << get_name() << std::endl;
-    std::cout << std::string(spaces + 2, ' ') << get_type() << std::endl;
+void CaseBranchNode::dump_node(uint spaces) {
+    out.indent(spaces) << '#' << SourceMap::local_line(get_line_number()) << '\n';
+    out.indent(spaces) << "_branch" << '\n';
+    out.indent(spaces + 2) << get_name() << '\n';
+    out.indent(spaces + 2) << get_type() << '\n';
     get_expr()->dump(spaces + 2);
 }
 
-void DispatchNode::dump(uint spaces) {
-    std::cout << std::string(spaces, ' ') << '#' << get_line_number() << std::endl;
-    std::cout << std::string(spaces, ' ') << "_dispatch" << std::endl;
+void DispatchNode::dump_node(uint spaces) {
+    out.indent(spaces) << '#' << SourceMap::local_line(get_line_number()) << '\n';
+    out.indent(spaces) << "_dispatch" << '\n';
     get_object()->dump(spaces + 2);
-    std::cout << std::string(spaces + 2, ' ') << get_method_name() << std::endl;
-    std::cout << std::string(spaces + 2, ' ') << '(' << std::endl;
+    out.indent(spaces + 2) << get_method_name() << '\n';
+    out.indent(spaces + 2) << '(' << '\n';
 
     for (ExpressionNode* parameter : get_parameters()) {
         parameter->dump(spaces + 2);
     }
 
-    std::cout << std::string(spaces + 2, ' ') << ')' << std::endl;
-    std::cout << std::string(spaces, ' ') << ": " << get_checked_type() << std::endl;
+    out.indent(spaces + 2) << ')' << '\n';
+    out.indent(spaces) << ": " << get_checked_type() << '\n';
 }
 
-void StaticDispatchNode::dump(uint spaces) {
-    std::cout << std::string(spaces, ' ') << '#' << get_line_number() << std::endl;
-    std::cout << std::string(spaces, ' ') << "_static_dispatch" << std::endl;
+void StaticDispatchNode::dump_node(uint spaces) {
+    out.indent(spaces) << '#' << SourceMap::local_line(get_line_number()) << '\n';
+    out.indent(spaces) << "_static_dispatch" << '\n';
     get_object()->dump(spaces + 2);
-    std::cout << std::string(spaces + 2, ' ') << get_static_type() << std::endl;
-    std::cout << std::string(spaces + 2, ' ') << get_method_name() << std::endl;
-    std::cout << std::string(spaces + 2, ' ') << '(' << std::endl;
+    out.indent(spaces + 2) << get_static_type() << '\n';
+    out.indent(spaces + 2) << get_method_name() << '\n';
+    out.indent(spaces + 2) << '(' << '\n';
 
     for (ExpressionNode* parameter : get_parameters()) {
         parameter->dump(spaces + 2);
     }
 
-    std::cout << std::string(spaces + 2, ' ') << ')' << std::endl;
-    std::cout << std::string(spaces, ' ') << ": " << get_checked_type() << std::endl;
+    out.indent(spaces + 2) << ')' << '\n';
+    out.indent(spaces) << ": " << get_checked_type() << '\n';
 }
\ No newline at end of file
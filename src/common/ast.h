@@ -4,17 +4,29 @@
 #include <iostream>
 #include <vector>
 #include <string>
+#include <string_view>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <cassert>
+#include "../common/arena.h"
 #include "../common/consts.h"
+#include "../common/symbol.h"
 #include "../utils/pretty_print.h"
+#include "../utils/stack_segments.h"
+#include "../utils/source_file.h"
+#include "../utils/errors.h"
 
 /*
  *  Abstract syntax tree.
  *  This file defines the types of nodes and their relationships.
  * 
- *  Implementing the 'typecheck' and 'code' methods is the task
+ *  Implementing the 'infer_type' and 'emit_code' methods is the task
  *  of the semantic analysis and code generation modules, respectively.
  */
 
+// the types of the nodes derived from each abstract node class
+// are kept contiguous, so that classof is a range check
 enum NodeType {
     ProgramNodeType,
     ClassNodeType,
@@ -22,6 +34,9 @@ enum NodeType {
     MethodNodeType,
     FormalsNodeType,
     FormalNodeType,
+    CaseBranchType,
+
+    // expressions
     ExpressionNodeType,
     NoExpressionNodeType,
     IntNodeType,
@@ -30,7 +45,13 @@ enum NodeType {
     IdentifierNodeType,
     AssignmentNodeType,
     NewNodeType,
+
+    // unary operations
     IsvoidNodeType,
+    NegNodeType,
+    ComplementNodeType,
+
+    // binary operations
     PlusNodeType,
     MinusNodeType,
     MultiplicationNodeType,
@@ -38,40 +59,45 @@ enum NodeType {
     LTNodeType,
     LTENodeType,
     EQNodeType,
-    NegNodeType,
-    ComplementNodeType,
+
     ConditionalNodeType,
     WhileNodeType,
     BlockNodeType,
     LetNodeType,
     LetInitializerType,
     CaseNodeType,
-    CaseBranchType,
     DispatchNodeType,
-    StaticDispatchNodeType
+    StaticDispatchNodeType,
+
+    NodeTypeCount
 };
 
+const char* get_node_type_name(NodeType);
+
 // forward declarations
 class ClassTable;
 class TypeEnvironment;
 
-enum Associativity {
-    LEFT,
-    RIGHT,
-    NONE
-};
-
 class Node {
     private:
-        NodeType type;
-        uint line_number = 0;
+        // the type tag and the line number share one word
+        uint32_t type : 8;
+        uint32_t line_number : 24;
 
     public:
-        Node(NodeType t) {
-            type = t;
+        // the largest line number that fits, across all files of the program
+        static constexpr uint MaxLineNumber = (1u << 24) - 1;
+
+        Node(NodeType t) : type(t), line_number(0) {}
+
+        NodeType get_node_type() const {
+            return static_cast<NodeType>(type);
         }
 
         void set_line_number(uint ln) {
+            if (ln > MaxLineNumber) {
+                line_number_error(ln, MaxLineNumber);
+            }
             line_number = ln;
         }
 
@@ -79,67 +105,119 @@ class Node {
             return line_number;
         }
 
-        virtual void dump(uint) = 0;
+        // displays the node and its children, see dump_node
+        void dump(uint);
+
+        virtual void dump_node(uint) = 0;
 };
 
-class ExpressionNode : public Node {
+// checked casts based on the node type tag instead of RTTI,
+// every node class provides a classof method for the check
+template <typename T>
+bool isa(const Node* node) {
+    return T::classof(node);
+}
+
+template <typename T>
+T* cast(Node* node) {
+    assert(isa<T>(node) && "cast to a node class of the wrong type");
+    return static_cast<T*>(node);
+}
+
+template <typename T>
+T* dyn_cast(Node* node) {
+    return isa<T>(node) ? static_cast<T*>(node) : nullptr;
+}
+
+// the children of a node, stored contiguously in the arena of the
+// program; lists are built in full by the parser and never change
+template <typename T>
+class NodeList {
     private:
-        std::string checked_type = Strings::Types::NoType;
+        T* items = nullptr;
+        uint32_t count = 0;
 
     public:
-        ExpressionNode(NodeType t) : Node(t) {}
+        NodeList() = default;
+        NodeList(T* first, size_t n) : items(first), count(n) {}
+        NodeList(Arena& arena, const std::vector<T>& list) : NodeList(arena.copy(list.data(), list.size()), list.size()) {}
 
-        std::string get_checked_type() {
-            return checked_type;
+        T* begin() const {
+            return items;
         }
 
-        void set_checked_type(const std::string& ct) {
-            checked_type = ct;
+        T* end() const {
+            return items + count;
+        }
+
+        std::reverse_iterator<T*> rbegin() const {
+            return std::reverse_iterator<T*>(end());
+        }
+
+        std::reverse_iterator<T*> rend() const {
+            return std::reverse_iterator<T*>(begin());
+        }
+
+        size_t size() const {
+            return count;
+        }
+
+        bool empty() const {
+            return count == 0;
+        }
+
+        T operator[](size_t i) const {
+            return items[i];
         }
 
-        virtual std::string typecheck(TypeEnvironment&) = 0;
-        virtual void code() = 0;
+        T front() const {
+            return items[0];
+        }
+
+        T back() const {
+            return items[count - 1];
+        }
 };
 
-class OperationNode : public ExpressionNode {
+class ExpressionNode : public Node {
     private:
-        uint precedence;
-        OperationNode* parent = 0;
-        bool parenthesized = false;
-    
+        Symbol checked_type = Symbols::Types::NoType;
+
     public:
-        OperationNode(NodeType t, uint p) : ExpressionNode(t), precedence(p) {};
-    
-        uint get_precedence() {
-            return precedence;
-        }
+        ExpressionNode(NodeType t) : Node(t) {}
 
-        OperationNode* get_parent() {
-            return parent;
+        static bool classof(const Node* node) {
+            return node->get_node_type() >= NodeType::ExpressionNodeType && node->get_node_type() <= NodeType::StaticDispatchNodeType;
         }
 
-        void set_parent(OperationNode* p) {
-            parent = p;
+        Symbol get_checked_type() {
+            return checked_type;
         }
 
-        bool is_parenthesized() {
-            return parenthesized;
+        void set_checked_type(Symbol ct) {
+            checked_type = ct;
         }
 
-        void set_parenthesized() {
-            parenthesized = true;
-        }
+        // the entry points for the semantic analysis and code generation
+        // of an expression, which continue on a new stack segment when
+        // the expression is nested deeply
+        Symbol typecheck(TypeEnvironment&);
+        void code();
 
-        virtual ExpressionNode* get_last() = 0;
-        virtual void set_last(ExpressionNode*) = 0;
+        virtual Symbol infer_type(TypeEnvironment&) = 0;
+        virtual void emit_code() = 0;
 };
 
-class UnaryOperationNode : public OperationNode {
+class UnaryOperationNode : public ExpressionNode {
     private:
         ExpressionNode* expr;
 
     public:
-        UnaryOperationNode(NodeType t, uint p) : OperationNode(t, p) {}
+        UnaryOperationNode(NodeType t) : ExpressionNode(t) {}
+
+        static bool classof(const Node* node) {
+            return node->get_node_type() >= NodeType::IsvoidNodeType && node->get_node_type() <= NodeType::ComplementNodeType;
+        }
 
         void set_expr(ExpressionNode* e) {
             expr = e;
@@ -148,24 +226,19 @@ class UnaryOperationNode : public OperationNode {
         ExpressionNode* get_expr() {
             return expr;
         }
-
-        ExpressionNode* get_last() {
-            return get_expr();
-        }
-
-        void set_last(ExpressionNode* e) {
-            set_expr(e);
-        }
 };
 
-class BinaryOperationNode : public OperationNode {
+class BinaryOperationNode : public ExpressionNode {
     private:
         ExpressionNode* expr1;
         ExpressionNode* expr2;
-        Associativity assoc;
 
     public:
-        BinaryOperationNode(NodeType t, uint p, Associativity a) : OperationNode(t, p), assoc(a) {}
+        BinaryOperationNode(NodeType t) : ExpressionNode(t) {}
+
+        static bool classof(const Node* node) {
+            return node->get_node_type() >= NodeType::PlusNodeType && node->get_node_type() <= NodeType::EQNodeType;
+        }
 
         void set_first(ExpressionNode* e) {
             expr1 = e;
@@ -182,66 +255,69 @@ class BinaryOperationNode : public OperationNode {
         ExpressionNode* get_second() {
             return expr2;
         }
-
-        Associativity get_associativity() {
-            return assoc;
-        }
-
-        ExpressionNode* get_last() {
-            return get_second();
-        }
-
-        void set_last(ExpressionNode* e) {
-            set_second(e);
-        }
 };
 
 class NoExpressionNode : public ExpressionNode {
     private:
-        std::string declared_type;
+        Symbol declared_type;
     
     public:
-        NoExpressionNode(const std::string& t) : ExpressionNode(NodeType::NoExpressionNodeType), declared_type(t) {}
+        NoExpressionNode(Symbol t) : ExpressionNode(NodeType::NoExpressionNodeType), declared_type(t) {}
 
-        std::string get_declared_type() {
+        static bool classof(const Node* node) {
+            return node->get_node_type() == NodeType::NoExpressionNodeType;
+        }
+
+        Symbol get_declared_type() {
             return declared_type;
         }
 
-        void dump(uint) override;
-        std::string typecheck(TypeEnvironment&) override;
-        void code() override;
+        void dump_node(uint) override;
+        Symbol infer_type(TypeEnvironment&) override;
+        void emit_code() override;
 };
 
 class IntNode : public ExpressionNode {
     private:
-        std::string value;
+        // the digits as written, in a copy in the arena; they are only
+        // wrapped to the 32-bit integers of the target when generating code
+        std::string_view value;
     
     public:
-        IntNode(const std::string& v) : ExpressionNode(NodeType::IntNodeType), value(v) {}
+        IntNode(std::string_view v) : ExpressionNode(NodeType::IntNodeType), value(v) {}
+
+        static bool classof(const Node* node) {
+            return node->get_node_type() == NodeType::IntNodeType;
+        }
 
-        std::string get_value() {
+        std::string_view get_value() {
             return value;
         }
 
-        void dump(uint) override;
-        std::string typecheck(TypeEnvironment&) override;
-        void code() override;
+        void dump_node(uint) override;
+        Symbol infer_type(TypeEnvironment&) override;
+        void emit_code() override;
 };
 
 class StringNode : public ExpressionNode {
     private:
-        std::string value;
+        // refers to a copy of the string in the arena
+        std::string_view value;
     
     public:
-        StringNode(const std::string& v) : ExpressionNode(NodeType::StringNodeType), value(v) {}
+        StringNode(std::string_view v) : ExpressionNode(NodeType::StringNodeType), value(v) {}
 
-        std::string get_value() {
+        static bool classof(const Node* node) {
+            return node->get_node_type() == NodeType::StringNodeType;
+        }
+
+        std::string_view get_value() {
             return value;
         }
 
-        void dump(uint) override;
-        std::string typecheck(TypeEnvironment&) override;
-        void code() override;
+        void dump_node(uint) override;
+        Symbol infer_type(TypeEnvironment&) override;
+        void emit_code() override;
 };
 
 class BoolNode : public ExpressionNode {
@@ -251,40 +327,52 @@ class BoolNode : public ExpressionNode {
     public:
         BoolNode(bool v) : ExpressionNode(NodeType::BoolNodeType), value(v) {}
 
+        static bool classof(const Node* node) {
+            return node->get_node_type() == NodeType::BoolNodeType;
+        }
+
         bool get_value() {
             return value;
         }
 
-        void dump(uint) override;
-        std::string typecheck(TypeEnvironment&) override;
-        void code() override;
+        void dump_node(uint) override;
+        Symbol infer_type(TypeEnvironment&) override;
+        void emit_code() override;
 };
 
 class IdentifierNode : public ExpressionNode {
     private:
-        std::string name;
+        Symbol name;
     
     public:
-        IdentifierNode(const std::string& n) : ExpressionNode(NodeType::IdentifierNodeType), name(n) {}
+        IdentifierNode(Symbol n) : ExpressionNode(NodeType::IdentifierNodeType), name(n) {}
+
+        static bool classof(const Node* node) {
+            return node->get_node_type() == NodeType::IdentifierNodeType;
+        }
 
-        std::string get_name() {
+        Symbol get_name() {
             return name;
         }
 
-        void dump(uint) override;
-        std::string typecheck(TypeEnvironment&) override;
-        void code() override;
+        void dump_node(uint) override;
+        Symbol infer_type(TypeEnvironment&) override;
+        void emit_code() override;
 };
 
 class AssignmentNode : public ExpressionNode {
     private:
-        std::string name;
+        Symbol name;
         ExpressionNode* expr;
     
     public:
-        AssignmentNode(const std::string& n) : ExpressionNode(NodeType::AssignmentNodeType), name(n) {}
+        AssignmentNode(Symbol n) : ExpressionNode(NodeType::AssignmentNodeType), name(n) {}
+
+        static bool classof(const Node* node) {
+            return node->get_node_type() == NodeType::AssignmentNodeType;
+        }
 
-        std::string get_name() {
+        Symbol get_name() {
             return name;
         }
 
@@ -296,105 +384,159 @@ class AssignmentNode : public ExpressionNode {
             return expr;
         }
 
-        void dump(uint) override;
-        std::string typecheck(TypeEnvironment&) override;
-        void code() override;
+        void dump_node(uint) override;
+        Symbol infer_type(TypeEnvironment&) override;
+        void emit_code() override;
 };
 
 class NewNode : public ExpressionNode {
     private:
-        std::string type;
+        Symbol type;
     
     public:
-        NewNode(const std::string& t) : ExpressionNode(NodeType::NewNodeType), type(t) {}
+        NewNode(Symbol t) : ExpressionNode(NodeType::NewNodeType), type(t) {}
+
+        static bool classof(const Node* node) {
+            return node->get_node_type() == NodeType::NewNodeType;
+        }
 
-        std::string get_type() {
+        Symbol get_type() {
             return type;
         }
 
-        void dump(uint) override;
-        std::string typecheck(TypeEnvironment&) override;
-        void code() override;
+        void dump_node(uint) override;
+        Symbol infer_type(TypeEnvironment&) override;
+        void emit_code() override;
 };
 
 class IsvoidNode : public UnaryOperationNode {   
     public:
-        IsvoidNode() : UnaryOperationNode(NodeType::IsvoidNodeType, 3) {}
-        void dump(uint) override;
-        std::string typecheck(TypeEnvironment&) override;
-        void code() override;
+        IsvoidNode() : UnaryOperationNode(NodeType::IsvoidNodeType) {}
+
+        static bool classof(const Node* node) {
+            return node->get_node_type() == NodeType::IsvoidNodeType;
+        }
+
+        void dump_node(uint) override;
+        Symbol infer_type(TypeEnvironment&) override;
+        void emit_code() override;
 };
 
 class NegNode : public UnaryOperationNode {   
     public:
-        NegNode() : UnaryOperationNode(NodeType::NegNodeType, 2) {}
-        void dump(uint) override;
-        std::string typecheck(TypeEnvironment&) override;
-        void code() override;
+        NegNode() : UnaryOperationNode(NodeType::NegNodeType) {}
+
+        static bool classof(const Node* node) {
+            return node->get_node_type() == NodeType::NegNodeType;
+        }
+
+        void dump_node(uint) override;
+        Symbol infer_type(TypeEnvironment&) override;
+        void emit_code() override;
 };
 
 class ComplementNode : public UnaryOperationNode {
     public:
-        ComplementNode() : UnaryOperationNode(NodeType::ComplementNodeType, 7) {}
-        void dump(uint) override;
-        std::string typecheck(TypeEnvironment&) override;
-        void code() override;
+        ComplementNode() : UnaryOperationNode(NodeType::ComplementNodeType) {}
+
+        static bool classof(const Node* node) {
+            return node->get_node_type() == NodeType::ComplementNodeType;
+        }
+
+        void dump_node(uint) override;
+        Symbol infer_type(TypeEnvironment&) override;
+        void emit_code() override;
 };
 
 class PlusNode : public BinaryOperationNode {
     public:
-        PlusNode() : BinaryOperationNode(NodeType::PlusNodeType, 5, Associativity::LEFT) {}
-        void dump(uint) override;
-        std::string typecheck(TypeEnvironment&) override;
-        void code() override;
+        PlusNode() : BinaryOperationNode(NodeType::PlusNodeType) {}
+
+        static bool classof(const Node* node) {
+            return node->get_node_type() == NodeType::PlusNodeType;
+        }
+
+        void dump_node(uint) override;
+        Symbol infer_type(TypeEnvironment&) override;
+        void emit_code() override;
 };
 
 class MinusNode : public BinaryOperationNode {
     public:
-        MinusNode() : BinaryOperationNode(NodeType::MinusNodeType, 5, Associativity::LEFT) {}
-        void dump(uint) override;
-        std::string typecheck(TypeEnvironment&) override;
-        void code() override;
+        MinusNode() : BinaryOperationNode(NodeType::MinusNodeType) {}
+
+        static bool classof(const Node* node) {
+            return node->get_node_type() == NodeType::MinusNodeType;
+        }
+
+        void dump_node(uint) override;
+        Symbol infer_type(TypeEnvironment&) override;
+        void emit_code() override;
 };
 
 class MultiplicationNode : public BinaryOperationNode {
     public:
-        MultiplicationNode() : BinaryOperationNode(NodeType::MultiplicationNodeType, 4, Associativity::LEFT) {}
-        void dump(uint) override;
-        std::string typecheck(TypeEnvironment&) override;
-        void code() override;
+        MultiplicationNode() : BinaryOperationNode(NodeType::MultiplicationNodeType) {}
+
+        static bool classof(const Node* node) {
+            return node->get_node_type() == NodeType::MultiplicationNodeType;
+        }
+
+        void dump_node(uint) override;
+        Symbol infer_type(TypeEnvironment&) override;
+        void emit_code() override;
 };
 
 class DivisionNode : public BinaryOperationNode {
     public:
-        DivisionNode() : BinaryOperationNode(NodeType::DivisionNodeType, 4, Associativity::LEFT) {}
-        void dump(uint) override;
-        std::string typecheck(TypeEnvironment&) override;
-        void code() override;
+        DivisionNode() : BinaryOperationNode(NodeType::DivisionNodeType) {}
+
+        static bool classof(const Node* node) {
+            return node->get_node_type() == NodeType::DivisionNodeType;
+        }
+
+        void dump_node(uint) override;
+        Symbol infer_type(TypeEnvironment&) override;
+        void emit_code() override;
 };
 
 class LTNode : public BinaryOperationNode {
     public:
-        LTNode() : BinaryOperationNode(NodeType::LTNodeType, 6, Associativity::NONE) {}
-        void dump(uint) override;
-        std::string typecheck(TypeEnvironment&) override;
-        void code() override;
+        LTNode() : BinaryOperationNode(NodeType::LTNodeType) {}
+
+        static bool classof(const Node* node) {
+            return node->get_node_type() == NodeType::LTNodeType;
+        }
+
+        void dump_node(uint) override;
+        Symbol infer_type(TypeEnvironment&) override;
+        void emit_code() override;
 };
 
 class LTENode : public BinaryOperationNode {
     public:
-        LTENode() : BinaryOperationNode(NodeType::LTENodeType, 6, Associativity::NONE) {}
-        void dump(uint) override;
-        std::string typecheck(TypeEnvironment&) override;
-        void code() override;
+        LTENode() : BinaryOperationNode(NodeType::LTENodeType) {}
+
+        static bool classof(const Node* node) {
+            return node->get_node_type() == NodeType::LTENodeType;
+        }
+
+        void dump_node(uint) override;
+        Symbol infer_type(TypeEnvironment&) override;
+        void emit_code() override;
 };
 
 class EQNode : public BinaryOperationNode {
     public:
-        EQNode() : BinaryOperationNode(NodeType::EQNodeType, 6, Associativity::NONE) {}
-        void dump(uint) override;
-        std::string typecheck(TypeEnvironment&) override;
-        void code() override;
+        EQNode() : BinaryOperationNode(NodeType::EQNodeType) {}
+
+        static bool classof(const Node* node) {
+            return node->get_node_type() == NodeType::EQNodeType;
+        }
+
+        void dump_node(uint) override;
+        Symbol infer_type(TypeEnvironment&) override;
+        void emit_code() override;
 };
 
 class ConditionalNode : public ExpressionNode {
@@ -406,6 +548,10 @@ class ConditionalNode : public ExpressionNode {
     public:
         ConditionalNode() : ExpressionNode(NodeType::ConditionalNodeType) {}
 
+        static bool classof(const Node* node) {
+            return node->get_node_type() == NodeType::ConditionalNodeType;
+        }
+
         void set_predicate(ExpressionNode* e) {
             predicate_expr = e;
         };
@@ -430,9 +576,9 @@ class ConditionalNode : public ExpressionNode {
             return else_expr;
         }                
 
-        void dump(uint) override;
-        std::string typecheck(TypeEnvironment&) override;
-        void code() override;
+        void dump_node(uint) override;
+        Symbol infer_type(TypeEnvironment&) override;
+        void emit_code() override;
 };
 
 class WhileNode : public ExpressionNode {
@@ -443,6 +589,10 @@ class WhileNode : public ExpressionNode {
     public:
         WhileNode() : ExpressionNode(NodeType::WhileNodeType) {}
 
+        static bool classof(const Node* node) {
+            return node->get_node_type() == NodeType::WhileNodeType;
+        }
+
         void set_predicate(ExpressionNode* e) {
             predicate = e;
         };
@@ -459,45 +609,53 @@ class WhileNode : public ExpressionNode {
             return body;
         }        
 
-        void dump(uint) override;
-        std::string typecheck(TypeEnvironment&) override;
-        void code() override;
+        void dump_node(uint) override;
+        Symbol infer_type(TypeEnvironment&) override;
+        void emit_code() override;
 };
 
 class BlockNode : public ExpressionNode {
     private:
-        std::vector<ExpressionNode*> expressions;
+        NodeList<ExpressionNode*> expressions;
     
     public:
         BlockNode() : ExpressionNode(NodeType::BlockNodeType) {}
 
-        void add_expression(ExpressionNode* e) {
-            expressions.push_back(e);
+        static bool classof(const Node* node) {
+            return node->get_node_type() == NodeType::BlockNodeType;
         }
 
-        std::vector<ExpressionNode*> get_expressions() {
+        void set_expressions(NodeList<ExpressionNode*> e) {
+            expressions = e;
+        }
+
+        NodeList<ExpressionNode*> get_expressions() {
             return expressions;
         }    
 
-        void dump(uint) override;
-        std::string typecheck(TypeEnvironment&) override;
-        void code() override;
+        void dump_node(uint) override;
+        Symbol infer_type(TypeEnvironment&) override;
+        void emit_code() override;
 };
 
 class LetInitializerNode : public ExpressionNode {
     private:
-        std::string name;
-        std::string type;
+        Symbol name;
+        Symbol type;
         ExpressionNode* expr;
     
     public:
-        LetInitializerNode(const std::string& n, const std::string& t) : ExpressionNode(NodeType::LetInitializerType), name(n), type(t) {}
+        LetInitializerNode(Symbol n, Symbol t) : ExpressionNode(NodeType::LetInitializerType), name(n), type(t) {}
+
+        static bool classof(const Node* node) {
+            return node->get_node_type() == NodeType::LetInitializerType;
+        }
 
-        std::string get_name() {
+        Symbol get_name() {
             return name;
         }
 
-        std::string get_type() {
+        Symbol get_type() {
             return type;
         }
 
@@ -509,19 +667,23 @@ class LetInitializerNode : public ExpressionNode {
             expr = e;
         }
 
-        void dump(uint) override;
-        std::string typecheck(TypeEnvironment&) override;
-        void code() override;
+        void dump_node(uint) override;
+        Symbol infer_type(TypeEnvironment&) override;
+        void emit_code() override;
 };
 
 class LetNode : public ExpressionNode {
     private:
-        std::vector<LetInitializerNode*> initializers;
+        NodeList<LetInitializerNode*> initializers;
         ExpressionNode* body;
     
     public:
         LetNode() : ExpressionNode(NodeType::LetNodeType) {}
 
+        static bool classof(const Node* node) {
+            return node->get_node_type() == NodeType::LetNodeType;
+        }
+
         void set_body(ExpressionNode* e) {
             body = e;
         };        
@@ -530,33 +692,37 @@ class LetNode : public ExpressionNode {
             return body;
         } 
 
-        void add_initializer(LetInitializerNode* i) {
-            initializers.push_back(i);
+        void set_initializers(NodeList<LetInitializerNode*> i) {
+            initializers = i;
         }
 
-        std::vector<LetInitializerNode*> get_initializers() {
+        NodeList<LetInitializerNode*> get_initializers() {
             return initializers;
         }    
 
-        void dump(uint) override;
-        std::string typecheck(TypeEnvironment&) override;
-        void code() override;
+        void dump_node(uint) override;
+        Symbol infer_type(TypeEnvironment&) override;
+        void emit_code() override;
 };
 
 class CaseBranchNode : public Node {
     private:
-        std::string name;
-        std::string type;
+        Symbol name;
+        Symbol type;
         ExpressionNode* expr;
 
     public:
-        CaseBranchNode(const std::string& n, const std::string& t) : Node(NodeType::CaseBranchType), name(n), type(t) {}
+        CaseBranchNode(Symbol n, Symbol t) : Node(NodeType::CaseBranchType), name(n), type(t) {}
 
-        std::string get_name() {
+        static bool classof(const Node* node) {
+            return node->get_node_type() == NodeType::CaseBranchType;
+        }
+
+        Symbol get_name() {
             return name;
         }
 
-        std::string get_type() {
+        Symbol get_type() {
             return type;
         }
 
@@ -568,17 +734,21 @@ class CaseBranchNode : public Node {
             return expr;
         }
 
-        void dump(uint) override;
+        void dump_node(uint) override;
 };
 
 class CaseNode : public ExpressionNode {
     private:
         ExpressionNode* target; // called expr0 in the COOL manual
-        std::vector<CaseBranchNode*> branches;
+        NodeList<CaseBranchNode*> branches;
     
     public:
         CaseNode() : ExpressionNode(NodeType::CaseNodeType) {}
 
+        static bool classof(const Node* node) {
+            return node->get_node_type() == NodeType::CaseNodeType;
+        }
+
         void set_target(ExpressionNode* t) {
             target = t;
         }
@@ -587,106 +757,118 @@ class CaseNode : public ExpressionNode {
             return target;
         }
 
-        void add_branch(CaseBranchNode* b) {
-            branches.push_back(b);
+        void set_branches(NodeList<CaseBranchNode*> b) {
+            branches = b;
         }
 
-        std::vector<CaseBranchNode*> get_branches() {
+        NodeList<CaseBranchNode*> get_branches() {
             return branches;
         }
 
-        void dump(uint) override;
-        std::string typecheck(TypeEnvironment&) override;
-        void code() override;
+        void dump_node(uint) override;
+        Symbol infer_type(TypeEnvironment&) override;
+        void emit_code() override;
 };
 
 class DispatchNode : public ExpressionNode {
     private:
         ExpressionNode* object;
-        std::string method_name;
-        std::vector<ExpressionNode*> parameters;
+        Symbol method_name;
+        NodeList<ExpressionNode*> parameters;
 
     public:
-        DispatchNode(ExpressionNode* o, const std::string& m) : ExpressionNode(NodeType::DispatchNodeType), object(o), method_name(m) {}
+        DispatchNode(ExpressionNode* o, Symbol m) : ExpressionNode(NodeType::DispatchNodeType), object(o), method_name(m) {}
+
+        static bool classof(const Node* node) {
+            return node->get_node_type() == NodeType::DispatchNodeType;
+        }
 
         ExpressionNode* get_object() {
             return object;
         }
 
-        std::string get_method_name() {
+        Symbol get_method_name() {
             return method_name;
         }
 
-        void add_parameter(ExpressionNode* e) {
-            parameters.push_back(e);
+        void set_parameters(NodeList<ExpressionNode*> p) {
+            parameters = p;
         }
 
-        std::vector<ExpressionNode*> get_parameters() {
+        NodeList<ExpressionNode*> get_parameters() {
             return parameters;
         }
 
-        void dump(uint) override;
-        std::string typecheck(TypeEnvironment&) override;
-        void code() override;
+        void dump_node(uint) override;
+        Symbol infer_type(TypeEnvironment&) override;
+        void emit_code() override;
 };
 
 class StaticDispatchNode : public ExpressionNode {
     private:
         ExpressionNode* object;
-        std::string method_name;
-        std::string static_type = "";
-        std::vector<ExpressionNode*> parameters;
+        Symbol method_name;
+        Symbol static_type;
+        NodeList<ExpressionNode*> parameters;
 
     public:
-        StaticDispatchNode(ExpressionNode* o, const std::string& m) : ExpressionNode(NodeType::DispatchNodeType), object(o), method_name(m) {}
+        StaticDispatchNode(ExpressionNode* o, Symbol m) : ExpressionNode(NodeType::StaticDispatchNodeType), object(o), method_name(m) {}
+
+        static bool classof(const Node* node) {
+            return node->get_node_type() == NodeType::StaticDispatchNodeType;
+        }
 
         ExpressionNode* get_object() {
             return object;
         }
 
-        std::string get_method_name() {
+        Symbol get_method_name() {
             return method_name;
         }
 
-        std::string get_static_type() {
+        Symbol get_static_type() {
             return static_type;
         }
 
-        void set_static_type(const std::string& st) {
+        void set_static_type(Symbol st) {
             static_type = st;
         }
 
-        void add_parameter(ExpressionNode* e) {
-            parameters.push_back(e);
+        void set_parameters(NodeList<ExpressionNode*> p) {
+            parameters = p;
         }
 
-        std::vector<ExpressionNode*> get_parameters() {
+        NodeList<ExpressionNode*> get_parameters() {
             return parameters;
         }
 
-        void dump(uint) override;
-        std::string typecheck(TypeEnvironment&) override;
-        void code() override;
+        void dump_node(uint) override;
+        Symbol infer_type(TypeEnvironment&) override;
+        void emit_code() override;
 };
 
 class FeatureNode : public Node {
     private:
-        std::string name;
-        std::string type;
+        Symbol name;
+        Symbol type;
         ExpressionNode* expr;
     
     public:
-        FeatureNode(NodeType t, const std::string& n) : Node(t), name(n) {}
+        FeatureNode(NodeType t, Symbol n) : Node(t), name(n) {}
 
-        std::string get_name() {
+        static bool classof(const Node* node) {
+            return node->get_node_type() >= NodeType::AttributeNodeType && node->get_node_type() <= NodeType::MethodNodeType;
+        }
+
+        Symbol get_name() {
             return name;
         }
 
-        std::string get_type() {
+        Symbol get_type() {
             return type;
         }
 
-        void set_type(const std::string& t) {
+        void set_type(Symbol t) {
             type = t;
         }
 
@@ -703,50 +885,63 @@ class FeatureNode : public Node {
 
 class AttributeNode : public FeatureNode {   
     public:
-        AttributeNode(const std::string& name) : FeatureNode(NodeType::AttributeNodeType, name) {}
-        void dump(uint) override;
+        AttributeNode(Symbol name) : FeatureNode(NodeType::AttributeNodeType, name) {}
+
+        static bool classof(const Node* node) {
+            return node->get_node_type() == NodeType::AttributeNodeType;
+        }
+
+        void dump_node(uint) override;
         void analyze(TypeEnvironment&) override;
 };
 
 class FormalNode : public Node {
     private:
-        std::string name;
-        std::string type;
+        Symbol name;
+        Symbol type;
     
     public:
-        FormalNode(const std::string& n, const std::string& t) : Node(NodeType::FormalNodeType), name(n), type(t) {}
+        FormalNode(Symbol n, Symbol t) : Node(NodeType::FormalNodeType), name(n), type(t) {}
 
-        std::string get_name() {
+        static bool classof(const Node* node) {
+            return node->get_node_type() == NodeType::FormalNodeType;
+        }
+
+        Symbol get_name() {
             return name;
         }
 
-        std::string get_type() {
+        Symbol get_type() {
             return type;
         }
 
-        void dump(uint) override;
+        void dump_node(uint) override;
 };
 
 class FormalsNode : public Node {
     private:
-        std::vector<FormalNode*> formals;
+        NodeList<FormalNode*> formals;
     
     public:
-        FormalsNode() : Node(NodeType::FormalNodeType) {}
+        FormalsNode() : Node(NodeType::FormalsNodeType) {}
 
-        std::vector<FormalNode*> get_formals() {
+        static bool classof(const Node* node) {
+            return node->get_node_type() == NodeType::FormalsNodeType;
+        }
+
+        NodeList<FormalNode*> get_formals() {
             return formals;
         }
 
-        void add_formal(FormalNode* formal) {
-            formals.push_back(formal);
+        void set_formals(NodeList<FormalNode*> f) {
+            formals = f;
         }
 
         size_t length() {
             return formals.size();
         }
 
-        void dump(uint) override;
+        void dump_node(uint) override;
 };
 
 class MethodNode : public FeatureNode {
@@ -754,7 +949,11 @@ class MethodNode : public FeatureNode {
         FormalsNode* formals;
 
     public:
-        MethodNode(const std::string& name) : FeatureNode(NodeType::MethodNodeType, name) {}
+        MethodNode(Symbol name) : FeatureNode(NodeType::MethodNodeType, name) {}
+
+        static bool classof(const Node* node) {
+            return node->get_node_type() == NodeType::MethodNodeType;
+        }
 
         FormalsNode* get_formals() {
             return formals;
@@ -764,68 +963,90 @@ class MethodNode : public FeatureNode {
             formals = f;
         }
 
-        void dump(uint) override;
+        void dump_node(uint) override;
         void analyze(TypeEnvironment&) override;
 };
 
 class ClassNode : public Node {
     private:
-        std::string name;
-        std::string base_class;
-        std::vector<FeatureNode*> features;
+        Symbol name;
+        Symbol base_class;
+        NodeList<FeatureNode*> features;
 
         // also track attributes and methods separately for convenience
-        std::vector<AttributeNode*> attributes;
-        std::vector<MethodNode*> methods;
+        NodeList<AttributeNode*> attributes;
+        NodeList<MethodNode*> methods;
     
     public:
-        ClassNode(const std::string& n) : Node(NodeType::ClassNodeType), name(n) {}
+        ClassNode(Symbol n) : Node(NodeType::ClassNodeType), name(n) {}
+
+        static bool classof(const Node* node) {
+            return node->get_node_type() == NodeType::ClassNodeType;
+        }
 
-        std::string get_name() {
+        Symbol get_name() {
             return name;
         }
 
-        std::string get_base_class() {
+        Symbol get_base_class() {
             return base_class;
         }
 
-        std::vector<FeatureNode*> get_features() {
+        NodeList<FeatureNode*> get_features() {
             return features;
         }
 
-        std::vector<AttributeNode*> get_attributes() {
+        NodeList<AttributeNode*> get_attributes() {
             return attributes;
         }
 
-        std::vector<MethodNode*> get_methods() {
+        NodeList<MethodNode*> get_methods() {
             return methods;
         }
 
-        void add_attribute(AttributeNode* attribute) {
-            features.push_back(attribute);
-            attributes.push_back(attribute);
-        }
+        void set_features(Arena& arena, NodeList<FeatureNode*> list) {
+            std::vector<AttributeNode*> attribute_list;
+            std::vector<MethodNode*> method_list;
+
+            for (FeatureNode* feature : list) {
+                if (MethodNode* method = dyn_cast<MethodNode>(feature)) {
+                    method_list.push_back(method);
+                } else {
+                    attribute_list.push_back(cast<AttributeNode>(feature));
+                }
+            }
 
-        void add_method(MethodNode* method) {
-            features.push_back(method);
-            methods.push_back(method);
+            features = list;
+            attributes = NodeList<AttributeNode*>(arena, attribute_list);
+            methods = NodeList<MethodNode*>(arena, method_list);
         }
 
-        void set_base_class(const std::string& bc) {
+        void set_base_class(Symbol bc) {
             base_class = bc;
         }
 
-        void dump(uint) override;
+        void dump_node(uint) override;
         void analyze(TypeEnvironment&);
 };
 
 class ProgramNode : public Node {
     private:
+        // owns every node of the program, including the basic
+        // classes, which are all freed when the program is destroyed
+        std::unique_ptr<Arena> arena = std::make_unique<Arena>();
         std::vector<ClassNode*> classes;
     
     public:
         ProgramNode() : Node(NodeType::ProgramNodeType) {}
 
+        static bool classof(const Node* node) {
+            return node->get_node_type() == NodeType::ProgramNodeType;
+        }
+
+        Arena& get_arena() {
+            return *arena;
+        }
+
         std::vector<ClassNode*> get_classes() {
             return classes;
         }
@@ -834,8 +1055,16 @@ class ProgramNode : public Node {
             classes.push_back(cls);
         }
 
-        void dump(uint) override;
-        ClassTable* analyze();
+        // appends the classes of a program parsed from another file
+        // and takes over the nodes that were allocated for them
+        void merge(ProgramNode& other) {
+            arena->adopt(*other.arena);
+            classes.insert(classes.end(), other.classes.begin(), other.classes.end());
+            other.classes.clear();
+        }
+
+        void dump_node(uint) override;
+        ClassTable* analyze(uint jobs = 1);
 };
 
 #endif
\ No newline at end of file
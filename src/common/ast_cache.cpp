@@ -0,0 +1,717 @@
+#include "ast_cache.h"
+
+/*
+ *  Binary format of the cached AST.
+ *
+ *  Numbers are stored in host byte order, the cache is never shared between
+ *  machines. An entry consists of a header with the key and a checksum of the
+ *  rest of the entry, the table of symbol names used by the program and the
+ *  nodes in pre-order. Every node
+ *  starts with its NodeType tag and line number, expressions also store their
+ *  checked type, followed by the fields and children of the node.
+ */
+
+static const char Magic[8] = { 'C', 'O', 'O', 'L', 'A', 'S', 'T', '\0' };
+
+// bumped whenever the layout of an entry or of the AST changes
+static constexpr uint32_t FormatVersion = 3;
+
+// entries written by a compiler built from other sources are never used, since
+// the AST or the way it is built may have changed in between; the Makefile
+// passes a hash of the compiler sources, other builds rely on FormatVersion
+#ifndef COOLR_SOURCE_HASH
+#define COOLR_SOURCE_HASH ""
+#endif
+static constexpr std::string_view CompilerBuild = COOLR_SOURCE_HASH;
+
+// 64-bit FNV-1a, used for both the cache keys and the checksums of the entries
+static uint64_t fnv1a(std::string_view data, uint64_t hash = 14695981039346656037ull) {
+    for (char c : data) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+//
+// writing
+//
+
+void AstWriter::write_u8(uint8_t value) {
+    out.push_back(static_cast<char>(value));
+}
+
+void AstWriter::write_u32(uint32_t value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void AstWriter::write_string(std::string_view value) {
+    write_u32(value.size());
+    out.append(value);
+}
+
+void AstWriter::write_symbol(Symbol symbol) {
+    auto [it, inserted] = symbol_index.try_emplace(symbol.get_id(), symbols.size());
+    if (inserted) {
+        symbols.push_back(symbol);
+    }
+    write_u32(it->second);
+}
+
+void AstWriter::write_expressions(NodeList<ExpressionNode*> expressions) {
+    write_u32(expressions.size());
+    for (ExpressionNode* expr : expressions) {
+        write_expression(expr);
+    }
+}
+
+void AstWriter::write_expression(ExpressionNode* expr) {
+    write_u8(expr->get_node_type());
+    write_u32(expr->get_line_number());
+    write_symbol(expr->get_checked_type());
+
+    // nested expressions go through here, like typecheck and code
+    StackSegments::nested([&] {
+        switch (expr->get_node_type()) {
+            case NodeType::NoExpressionNodeType:
+                write_symbol(cast<NoExpressionNode>(expr)->get_declared_type());
+                break;
+
+            case NodeType::IntNodeType:
+                write_string(cast<IntNode>(expr)->get_value());
+                break;
+
+            case NodeType::StringNodeType:
+                write_string(cast<StringNode>(expr)->get_value());
+                break;
+
+            case NodeType::BoolNodeType:
+                write_u8(cast<BoolNode>(expr)->get_value());
+                break;
+
+            case NodeType::IdentifierNodeType:
+                write_symbol(cast<IdentifierNode>(expr)->get_name());
+                break;
+
+            case NodeType::AssignmentNodeType: {
+                AssignmentNode* assign = cast<AssignmentNode>(expr);
+                write_symbol(assign->get_name());
+                write_expression(assign->get_expr());
+                break;
+            }
+
+            case NodeType::NewNodeType:
+                write_symbol(cast<NewNode>(expr)->get_type());
+                break;
+
+            case NodeType::IsvoidNodeType:
+            case NodeType::NegNodeType:
+            case NodeType::ComplementNodeType:
+                write_expression(cast<UnaryOperationNode>(expr)->get_expr());
+                break;
+
+            case NodeType::PlusNodeType:
+            case NodeType::MinusNodeType:
+            case NodeType::MultiplicationNodeType:
+            case NodeType::DivisionNodeType:
+            case NodeType::LTNodeType:
+            case NodeType::LTENodeType:
+            case NodeType::EQNodeType: {
+                BinaryOperationNode* op = cast<BinaryOperationNode>(expr);
+                write_expression(op->get_first());
+                write_expression(op->get_second());
+                break;
+            }
+
+            case NodeType::ConditionalNodeType: {
+                ConditionalNode* cond = cast<ConditionalNode>(expr);
+                write_expression(cond->get_predicate());
+                write_expression(cond->get_then());
+                write_expression(cond->get_else());
+                break;
+            }
+
+            case NodeType::WhileNodeType: {
+                WhileNode* loop = cast<WhileNode>(expr);
+                write_expression(loop->get_predicate());
+                write_expression(loop->get_body());
+                break;
+            }
+
+            case NodeType::BlockNodeType:
+                write_expressions(cast<BlockNode>(expr)->get_expressions());
+                break;
+
+            case NodeType::LetNodeType: {
+                LetNode* let = cast<LetNode>(expr);
+                NodeList<LetInitializerNode*> initializers = let->get_initializers();
+                write_u32(initializers.size());
+                for (LetInitializerNode* init : initializers) {
+                    write_expression(init);
+                }
+                write_expression(let->get_body());
+                break;
+            }
+
+            case NodeType::LetInitializerType: {
+                LetInitializerNode* init = cast<LetInitializerNode>(expr);
+                write_symbol(init->get_name());
+                write_symbol(init->get_type());
+                write_expression(init->get_expr());
+                break;
+            }
+
+            case NodeType::CaseNodeType: {
+                CaseNode* case_node = cast<CaseNode>(expr);
+                write_expression(case_node->get_target());
+
+                NodeList<CaseBranchNode*> branches = case_node->get_branches();
+                write_u32(branches.size());
+                for (CaseBranchNode* branch : branches) {
+                    write_u32(branch->get_line_number());
+                    write_symbol(branch->get_name());
+                    write_symbol(branch->get_type());
+                    write_expression(branch->get_expr());
+                }
+                break;
+            }
+
+            case NodeType::DispatchNodeType: {
+                DispatchNode* dispatch = cast<DispatchNode>(expr);
+                write_expression(dispatch->get_object());
+                write_symbol(dispatch->get_method_name());
+                write_expressions(dispatch->get_parameters());
+                break;
+            }
+
+            case NodeType::StaticDispatchNodeType: {
+                StaticDispatchNode* dispatch = cast<StaticDispatchNode>(expr);
+                write_expression(dispatch->get_object());
+                write_symbol(dispatch->get_method_name());
+                write_symbol(dispatch->get_static_type());
+                write_expressions(dispatch->get_parameters());
+                break;
+            }
+
+            default:
+                break;
+        }
+    });
+}
+
+void AstWriter::write_feature(FeatureNode* feature) {
+    write_u8(feature->get_node_type());
+    write_u32(feature->get_line_number());
+    write_symbol(feature->get_name());
+    write_symbol(feature->get_type());
+
+    if (MethodNode* method = dyn_cast<MethodNode>(feature)) {
+        FormalsNode* formals = method->get_formals();
+        write_u32(formals->get_line_number());
+        write_u32(formals->length());
+        for (FormalNode* formal : formals->get_formals()) {
+            write_u32(formal->get_line_number());
+            write_symbol(formal->get_name());
+            write_symbol(formal->get_type());
+        }
+    }
+
+    write_expression(feature->get_expr());
+}
+
+void AstWriter::write_class(ClassNode* cls) {
+    write_u32(cls->get_line_number());
+    write_symbol(cls->get_name());
+    write_symbol(cls->get_base_class());
+
+    NodeList<FeatureNode*> features = cls->get_features();
+    write_u32(features.size());
+    for (FeatureNode* feature : features) {
+        write_feature(feature);
+    }
+}
+
+std::string AstWriter::serialize(ProgramNode& program, uint64_t key, bool annotated) {
+    // the nodes are written first, so that the symbol table is complete
+    write_u32(program.get_line_number());
+    std::vector<ClassNode*> classes = program.get_classes();
+    write_u32(classes.size());
+    for (ClassNode* cls : classes) {
+        write_class(cls);
+    }
+
+    std::string nodes = std::move(out);
+    out.clear();
+
+    write_u8(annotated);
+
+    // symbols are listed in the order of their IDs, so interning them
+    // again keeps the relative order of the IDs of a fresh parse
+    std::vector<Symbol> sorted = symbols;
+    std::sort(sorted.begin(), sorted.end());
+    std::vector<uint32_t> position(symbols.size());
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        position[symbol_index[sorted[i].get_id()]] = i;
+    }
+
+    write_u32(sorted.size());
+    for (Symbol symbol : sorted) {
+        write_string(symbol.str());
+    }
+
+    // map the indices in the order of first use to the sorted table
+    write_u32(position.size());
+    for (uint32_t p : position) {
+        write_u32(p);
+    }
+
+    out.append(nodes);
+    std::string body = std::move(out);
+    out.clear();
+
+    uint64_t checksum = fnv1a(body);
+    out.append(Magic, sizeof(Magic));
+    write_u32(FormatVersion);
+    out.append(reinterpret_cast<const char*>(&key), sizeof(key));
+    out.append(reinterpret_cast<const char*>(&checksum), sizeof(checksum));
+
+    out.append(body);
+    return std::move(out);
+}
+
+//
+// reading
+//
+
+uint8_t AstReader::read_u8() {
+    if (end - cursor < 1) {
+        ok = false;
+        return 0;
+    }
+    return static_cast<uint8_t>(*cursor++);
+}
+
+uint32_t AstReader::read_u32() {
+    uint32_t value = 0;
+    if (end - cursor < static_cast<ptrdiff_t>(sizeof(value))) {
+        ok = false;
+        return 0;
+    }
+    std::memcpy(&value, cursor, sizeof(value));
+    cursor += sizeof(value);
+    return value;
+}
+
+std::string_view AstReader::read_string() {
+    uint32_t length = read_u32();
+    if (static_cast<size_t>(end - cursor) < length) {
+        ok = false;
+        return {};
+    }
+    std::string_view value(cursor, length);
+    cursor += length;
+    return value;
+}
+
+Symbol AstReader::read_symbol() {
+    uint32_t index = read_u32();
+    if (index >= symbols.size()) {
+        ok = false;
+        return Symbol();
+    }
+    return symbols[index];
+}
+
+uint32_t AstReader::read_count() {
+    // every element takes at least one byte, which bounds the count of a corrupt entry
+    uint32_t count = read_u32();
+    if (static_cast<size_t>(end - cursor) < count) {
+        ok = false;
+        return 0;
+    }
+    return count;
+}
+
+ExpressionNode* AstReader::read_expression() {
+    uint8_t type = read_u8();
+    uint32_t line_number = read_u32();
+    Symbol checked_type = read_symbol();
+
+    if (!ok || type < NodeType::NoExpressionNodeType || type > NodeType::StaticDispatchNodeType) {
+        ok = false;
+        return nullptr;
+    }
+
+    ExpressionNode* expr = StackSegments::nested([&] {
+        return read_expression_node(static_cast<NodeType>(type));
+    });
+
+    if (!ok) {
+        return nullptr;
+    }
+
+    expr->set_line_number(line_number);
+    if (annotations) {
+        expr->set_checked_type(checked_type);
+    }
+
+    return expr;
+}
+
+NodeList<ExpressionNode*> AstReader::read_expressions() {
+    std::vector<ExpressionNode*> expressions;
+    for (uint32_t i = 0, n = read_count(); i < n && ok; ++i) {
+        expressions.push_back(read_expression());
+    }
+    return NodeList<ExpressionNode*>(*arena, expressions);
+}
+
+ExpressionNode* AstReader::read_expression_node(NodeType type) {
+    switch (type) {
+        case NodeType::NoExpressionNodeType:
+            return arena->make<NoExpressionNode>(read_symbol());
+
+        case NodeType::IntNodeType:
+        {
+            std::string_view value = read_string();
+            return arena->make<IntNode>(std::string_view(arena->copy(value.data(), value.size()), value.size()));
+        }
+
+        case NodeType::StringNodeType:
+        {
+            std::string_view value = read_string();
+            return arena->make<StringNode>(std::string_view(arena->copy(value.data(), value.size()), value.size()));
+        }
+
+        case NodeType::BoolNodeType:
+            return arena->make<BoolNode>(read_u8() != 0);
+
+        case NodeType::IdentifierNodeType:
+            return arena->make<IdentifierNode>(read_symbol());
+
+        case NodeType::AssignmentNodeType: {
+            AssignmentNode* assign = arena->make<AssignmentNode>(read_symbol());
+            assign->set_expr(read_expression());
+            return assign;
+        }
+
+        case NodeType::NewNodeType:
+            return arena->make<NewNode>(read_symbol());
+
+        case NodeType::IsvoidNodeType:
+        case NodeType::NegNodeType:
+        case NodeType::ComplementNodeType: {
+            UnaryOperationNode* op;
+            switch (type) {
+                case NodeType::IsvoidNodeType: op = arena->make<IsvoidNode>(); break;
+                case NodeType::NegNodeType: op = arena->make<NegNode>(); break;
+                default: op = arena->make<ComplementNode>(); break;
+            }
+            op->set_expr(read_expression());
+            return op;
+        }
+
+        case NodeType::PlusNodeType:
+        case NodeType::MinusNodeType:
+        case NodeType::MultiplicationNodeType:
+        case NodeType::DivisionNodeType:
+        case NodeType::LTNodeType:
+        case NodeType::LTENodeType:
+        case NodeType::EQNodeType: {
+            BinaryOperationNode* op;
+            switch (type) {
+                case NodeType::PlusNodeType: op = arena->make<PlusNode>(); break;
+                case NodeType::MinusNodeType: op = arena->make<MinusNode>(); break;
+                case NodeType::MultiplicationNodeType: op = arena->make<MultiplicationNode>(); break;
+                case NodeType::DivisionNodeType: op = arena->make<DivisionNode>(); break;
+                case NodeType::LTNodeType: op = arena->make<LTNode>(); break;
+                case NodeType::LTENodeType: op = arena->make<LTENode>(); break;
+                default: op = arena->make<EQNode>(); break;
+            }
+            op->set_first(read_expression());
+            op->set_second(read_expression());
+            return op;
+        }
+
+        case NodeType::ConditionalNodeType: {
+            ConditionalNode* cond = arena->make<ConditionalNode>();
+            cond->set_predicate(read_expression());
+            cond->set_then(read_expression());
+            cond->set_else(read_expression());
+            return cond;
+        }
+
+        case NodeType::WhileNodeType: {
+            WhileNode* loop = arena->make<WhileNode>();
+            loop->set_predicate(read_expression());
+            loop->set_body(read_expression());
+            return loop;
+        }
+
+        case NodeType::BlockNodeType: {
+            BlockNode* block = arena->make<BlockNode>();
+            block->set_expressions(read_expressions());
+            return block;
+        }
+
+        case NodeType::LetNodeType: {
+            LetNode* let = arena->make<LetNode>();
+            std::vector<LetInitializerNode*> initializers;
+            for (uint32_t i = 0, n = read_count(); i < n && ok; ++i) {
+                ExpressionNode* init = read_expression();
+                if (!ok || !isa<LetInitializerNode>(init)) {
+                    ok = false;
+                    return let;
+                }
+                initializers.push_back(cast<LetInitializerNode>(init));
+            }
+            let->set_initializers(NodeList<LetInitializerNode*>(*arena, initializers));
+            let->set_body(read_expression());
+            return let;
+        }
+
+        case NodeType::LetInitializerType: {
+            Symbol name = read_symbol();
+            Symbol declared_type = read_symbol();
+            LetInitializerNode* init = arena->make<LetInitializerNode>(name, declared_type);
+            init->set_expr(read_expression());
+            return init;
+        }
+
+        case NodeType::CaseNodeType: {
+            CaseNode* case_node = arena->make<CaseNode>();
+            case_node->set_target(read_expression());
+            std::vector<CaseBranchNode*> branches;
+            for (uint32_t i = 0, n = read_count(); i < n && ok; ++i) {
+                uint32_t line_number = read_u32();
+                Symbol name = read_symbol();
+                Symbol declared_type = read_symbol();
+                CaseBranchNode* branch = arena->make<CaseBranchNode>(name, declared_type);
+                branch->set_line_number(line_number);
+                branch->set_expr(read_expression());
+                branches.push_back(branch);
+            }
+            case_node->set_branches(NodeList<CaseBranchNode*>(*arena, branches));
+            return case_node;
+        }
+
+        case NodeType::DispatchNodeType: {
+            ExpressionNode* object = read_expression();
+            DispatchNode* dispatch = arena->make<DispatchNode>(object, read_symbol());
+            dispatch->set_parameters(read_expressions());
+            return dispatch;
+        }
+
+        case NodeType::StaticDispatchNodeType: {
+            ExpressionNode* object = read_expression();
+            StaticDispatchNode* dispatch = arena->make<StaticDispatchNode>(object, read_symbol());
+            dispatch->set_static_type(read_symbol());
+            dispatch->set_parameters(read_expressions());
+            return dispatch;
+        }
+
+        default:
+            // abstract node types never appear in a valid entry
+            ok = false;
+            return arena->make<NoExpressionNode>(Symbol());
+    }
+}
+
+FeatureNode* AstReader::read_feature() {
+    uint8_t type = read_u8();
+    uint32_t line_number = read_u32();
+    Symbol name = read_symbol();
+    Symbol declared_type = read_symbol();
+
+    FeatureNode* feature;
+    if (type == NodeType::MethodNodeType) {
+        MethodNode* method = arena->make<MethodNode>(name);
+        FormalsNode* formals = arena->make<FormalsNode>();
+        formals->set_line_number(read_u32());
+
+        std::vector<FormalNode*> formal_list;
+        for (uint32_t i = 0, n = read_count(); i < n && ok; ++i) {
+            uint32_t formal_line_number = read_u32();
+            Symbol formal_name = read_symbol();
+            Symbol formal_type = read_symbol();
+            FormalNode* formal = arena->make<FormalNode>(formal_name, formal_type);
+            formal->set_line_number(formal_line_number);
+            formal_list.push_back(formal);
+        }
+        formals->set_formals(NodeList<FormalNode*>(*arena, formal_list));
+
+        method->set_formals(formals);
+        feature = method;
+    } else if (type == NodeType::AttributeNodeType) {
+        feature = arena->make<AttributeNode>(name);
+    } else {
+        ok = false;
+        return nullptr;
+    }
+
+    feature->set_line_number(line_number);
+    feature->set_type(declared_type);
+    feature->set_expr(read_expression());
+    return feature;
+}
+
+ClassNode* AstReader::read_class() {
+    uint32_t line_number = read_u32();
+    ClassNode* cls = arena->make<ClassNode>(read_symbol());
+    cls->set_line_number(line_number);
+    cls->set_base_class(read_symbol());
+
+    std::vector<FeatureNode*> features;
+    for (uint32_t i = 0, n = read_count(); i < n && ok; ++i) {
+        FeatureNode* feature = read_feature();
+        if (!ok) {
+            break;
+        }
+        features.push_back(feature);
+    }
+
+    cls->set_features(*arena, NodeList<FeatureNode*>(*arena, features));
+
+    return cls;
+}
+
+bool AstReader::deserialize(ProgramNode& program, uint64_t key, bool keep_annotations, bool& annotated) {
+    if (end - cursor < static_cast<ptrdiff_t>(sizeof(Magic)) || std::memcmp(cursor, Magic, sizeof(Magic)) != 0) {
+        return false;
+    }
+    cursor += sizeof(Magic);
+
+    uint64_t stored_key = 0;
+    uint64_t checksum = 0;
+    if (read_u32() != FormatVersion || end - cursor < static_cast<ptrdiff_t>(sizeof(stored_key) + sizeof(checksum))) {
+        return false;
+    }
+    std::memcpy(&stored_key, cursor, sizeof(stored_key));
+    cursor += sizeof(stored_key);
+    std::memcpy(&checksum, cursor, sizeof(checksum));
+    cursor += sizeof(checksum);
+
+    // the symbols are interned as they are read, so a damaged
+    // entry has to be rejected before any of it is used
+    if (stored_key != key || fnv1a(std::string_view(cursor, end - cursor)) != checksum) {
+        return false;
+    }
+
+    annotations = read_u8() != 0 && keep_annotations;
+
+    std::vector<Symbol> sorted;
+    for (uint32_t i = 0, n = read_count(); i < n && ok; ++i) {
+        sorted.push_back(Symbol::intern(read_string()));
+    }
+
+    for (uint32_t i = 0, n = read_count(); i < n && ok; ++i) {
+        uint32_t position = read_u32();
+        if (position >= sorted.size()) {
+            return false;
+        }
+        symbols.push_back(sorted[position]);
+    }
+
+    // build the nodes in a separate program, which is only kept if the entry is valid
+    ProgramNode loaded;
+    arena = &loaded.get_arena();
+    loaded.set_line_number(read_u32());
+
+    for (uint32_t i = 0, n = read_count(); i < n && ok; ++i) {
+        ClassNode* cls = read_class();
+        if (ok) {
+            loaded.add_class(cls);
+        }
+    }
+
+    if (!ok || cursor != end) {
+        return false;
+    }
+
+    annotated = annotations;
+    program = std::move(loaded);
+    return true;
+}
+
+//
+// cache entries
+//
+
+std::string AstCache::default_directory() {
+    if (const char* xdg = std::getenv("XDG_CACHE_HOME"); xdg && *xdg) {
+        return std::string(xdg) + "/coolr";
+    }
+
+    if (const char* home = std::getenv("HOME"); home && *home) {
+        return std::string(home) + "/.cache/coolr";
+    }
+
+    return ".coolr-cache";
+}
+
+uint64_t AstCache::key(std::string_view source) {
+    return fnv1a(CompilerBuild, fnv1a(source));
+}
+
+std::filesystem::path AstCache::entry_path(uint64_t key) {
+    static const char digits[] = "0123456789abcdef";
+
+    std::string name(16, '0');
+    for (int i = 15; i >= 0; --i, key >>= 4) {
+        name[i] = digits[key & 0xf];
+    }
+
+    return directory / (name + ".coolast");
+}
+
+bool AstCache::load(std::string_view source, ProgramNode& program, bool keep_annotations, bool& annotated) {
+    uint64_t k = key(source);
+    annotated = false;
+
+    std::ifstream in(entry_path(k), std::ios::binary);
+    std::string data;
+    if (in) {
+        data.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    if (!in || !AstReader(data).deserialize(program, k, keep_annotations, annotated)) {
+        misses++;
+        return false;
+    }
+
+    hits++;
+    annotated_hits += annotated;
+    return true;
+}
+
+void AstCache::store(std::string_view source, ProgramNode& program, bool annotated) {
+    uint64_t k = key(source);
+    std::string data = AstWriter().serialize(program, k, annotated);
+
+    // the cache is only an optimization, so failing to write it is not an error;
+    // entries are renamed into place so that concurrent compilers never see partial files
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+
+    std::filesystem::path path = entry_path(k);
+    std::filesystem::path temporary = path;
+    temporary += "." + std::to_string(getpid()) + ".tmp";
+
+    std::ofstream out(temporary, std::ios::binary);
+    if (!out.write(data.data(), data.size())) {
+        out.close();
+        std::filesystem::remove(temporary, error);
+        return;
+    }
+    out.close();
+
+    std::filesystem::rename(temporary, path, error);
+    if (error) {
+        std::filesystem::remove(temporary, error);
+    }
+}
+
+void AstCache::print_stats() {
+    std::cerr << "AST cache: " << hits << " hits (" << annotated_hits << " with types), "
+              << misses << " misses" << std::endl;
+}
@@ -0,0 +1,109 @@
+#ifndef AST_CACHE_H
+#define AST_CACHE_H
+
+#include <string>
+#include <iostream>
+#include <algorithm>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <fstream>
+#include <cstring>
+#include <cstdlib>
+#include <filesystem>
+#include <unistd.h>
+#include "ast.h"
+#include "symbol.h"
+#include "../utils/stack_segments.h"
+
+/*
+ *  Cache of parsed programs.
+ *
+ *  A parsed program is serialized into a compact binary .coolast file named
+ *  after a hash of the source and of the compiler sources. When the same source is
+ *  compiled again, the AST is rebuilt from the file instead of lexing and
+ *  parsing the source. Once a program has passed semantic analysis, the cached
+ *  AST also carries the inferred types, so the analysis can be skipped as well.
+ */
+
+class AstWriter {
+    private:
+        std::string out;
+
+        // symbols are written as indices into a table stored with the AST
+        std::unordered_map<uint, uint> symbol_index;
+        std::vector<Symbol> symbols;
+
+        void write_u8(uint8_t);
+        void write_u32(uint32_t);
+        void write_string(std::string_view);
+        void write_symbol(Symbol);
+
+        void write_class(ClassNode*);
+        void write_feature(FeatureNode*);
+        void write_expression(ExpressionNode*);
+        void write_expressions(NodeList<ExpressionNode*>);
+
+    public:
+        std::string serialize(ProgramNode&, uint64_t key, bool annotated);
+};
+
+class AstReader {
+    private:
+        const char* cursor;
+        const char* end;
+        bool ok = true;
+
+        Arena* arena = nullptr;
+        std::vector<Symbol> symbols;
+
+        // whether checked types are restored
+        bool annotations = false;
+
+        uint8_t read_u8();
+        uint32_t read_u32();
+        std::string_view read_string();
+        Symbol read_symbol();
+        uint32_t read_count();
+
+        ClassNode* read_class();
+        FeatureNode* read_feature();
+        ExpressionNode* read_expression();
+        NodeList<ExpressionNode*> read_expressions();
+        ExpressionNode* read_expression_node(NodeType);
+
+    public:
+        AstReader(std::string_view data) : cursor(data.data()), end(data.data() + data.size()) {}
+
+        // rebuilds the program, returns false if the data is not a valid cache entry for the key
+        bool deserialize(ProgramNode&, uint64_t key, bool keep_annotations, bool& annotated);
+};
+
+class AstCache {
+    private:
+        std::filesystem::path directory;
+
+        uint hits = 0;
+        uint annotated_hits = 0;
+        uint misses = 0;
+
+        std::filesystem::path entry_path(uint64_t key);
+
+    public:
+        AstCache(const std::string& dir) : directory(dir) {}
+
+        // the default location is $XDG_CACHE_HOME/coolr or ~/.cache/coolr
+        static std::string default_directory();
+
+        // hash of the source and the compiler sources that names the cache entry
+        static uint64_t key(std::string_view source);
+
+        // returns true if the program was found in the cache; annotated
+        // is set if the checked types were restored as well
+        bool load(std::string_view source, ProgramNode&, bool keep_annotations, bool& annotated);
+        void store(std::string_view source, ProgramNode&, bool annotated);
+
+        void print_stats();
+};
+
+#endif
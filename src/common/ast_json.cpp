@@ -0,0 +1,217 @@
+#include "ast_json.h"
+
+/*
+ *  Writes the abstract syntax tree as JSON lines, selected with --json.
+ */
+
+uint AstJson::begin(Node* node, uint parent) {
+    uint id = next_id++;
+    out << "{\"id\":" << id << ",\"parent\":" << parent << ",\"node\":\"" << get_node_type_name(node->get_node_type())
+        << "\",\"line\":" << SourceMap::local_line(node->get_line_number());
+    return id;
+}
+
+void AstJson::end(Node* node) {
+    if (ExpressionNode* expr = dyn_cast<ExpressionNode>(node)) {
+        field("type", expr->get_checked_type());
+    }
+    out << "}\n";
+}
+
+void AstJson::field(std::string_view name, Symbol value) {
+    field(name, std::string_view(value.str()));
+}
+
+void AstJson::field(std::string_view name, std::string_view value) {
+    out << ",\"" << name << "\":" << get_json_string(value);
+}
+
+void AstJson::write(ProgramNode& program) {
+    uint id = next_id++;
+    out << "{\"id\":" << id << ",\"node\":\"program\",\"line\":" << SourceMap::local_line(program.get_line_number()) << "}\n";
+
+    for (ClassNode* cls : program.get_classes()) {
+        write_class(cls, id);
+    }
+}
+
+void AstJson::write_class(ClassNode* cls, uint parent) {
+    uint id = begin(cls, parent);
+    field("name", cls->get_name());
+    field("base", cls->get_base_class());
+    end(cls);
+
+    for (FeatureNode* feature : cls->get_features()) {
+        write_feature(feature, id);
+    }
+}
+
+void AstJson::write_feature(FeatureNode* feature, uint parent) {
+    uint id = begin(feature, parent);
+    field("name", feature->get_name());
+    field("declared_type", feature->get_type());
+    end(feature);
+
+    if (MethodNode* method = dyn_cast<MethodNode>(feature)) {
+        for (FormalNode* formal : method->get_formals()->get_formals()) {
+            begin(formal, id);
+            field("name", formal->get_name());
+            field("declared_type", formal->get_type());
+            end(formal);
+        }
+    }
+
+    write_expression(feature->get_expr(), id);
+}
+
+void AstJson::write_expression(ExpressionNode* expr, uint parent) {
+    // nested expressions go through here, like typecheck and code
+    StackSegments::nested([&] {
+        uint id = begin(expr, parent);
+
+        switch (expr->get_node_type()) {
+            case NodeType::NoExpressionNodeType:
+                end(expr);
+                break;
+
+            case NodeType::IntNodeType:
+                field("value", cast<IntNode>(expr)->get_value());
+                end(expr);
+                break;
+
+            case NodeType::StringNodeType:
+                field("value", cast<StringNode>(expr)->get_value());
+                end(expr);
+                break;
+
+            case NodeType::BoolNodeType:
+                out << ",\"value\":" << (cast<BoolNode>(expr)->get_value() ? "true" : "false");
+                end(expr);
+                break;
+
+            case NodeType::IdentifierNodeType:
+                field("name", cast<IdentifierNode>(expr)->get_name());
+                end(expr);
+                break;
+
+            case NodeType::AssignmentNodeType: {
+                AssignmentNode* assign = cast<AssignmentNode>(expr);
+                field("name", assign->get_name());
+                end(expr);
+                write_expression(assign->get_expr(), id);
+                break;
+            }
+
+            case NodeType::NewNodeType:
+                field("declared_type", cast<NewNode>(expr)->get_type());
+                end(expr);
+                break;
+
+            case NodeType::IsvoidNodeType:
+            case NodeType::NegNodeType:
+            case NodeType::ComplementNodeType:
+                end(expr);
+                write_expression(cast<UnaryOperationNode>(expr)->get_expr(), id);
+                break;
+
+            case NodeType::PlusNodeType:
+            case NodeType::MinusNodeType:
+            case NodeType::MultiplicationNodeType:
+            case NodeType::DivisionNodeType:
+            case NodeType::LTNodeType:
+            case NodeType::LTENodeType:
+            case NodeType::EQNodeType: {
+                BinaryOperationNode* op = cast<BinaryOperationNode>(expr);
+                end(expr);
+                write_expression(op->get_first(), id);
+                write_expression(op->get_second(), id);
+                break;
+            }
+
+            case NodeType::ConditionalNodeType: {
+                ConditionalNode* cond = cast<ConditionalNode>(expr);
+                end(expr);
+                write_expression(cond->get_predicate(), id);
+                write_expression(cond->get_then(), id);
+                write_expression(cond->get_else(), id);
+                break;
+            }
+
+            case NodeType::WhileNodeType: {
+                WhileNode* loop = cast<WhileNode>(expr);
+                end(expr);
+                write_expression(loop->get_predicate(), id);
+                write_expression(loop->get_body(), id);
+                break;
+            }
+
+            case NodeType::BlockNodeType:
+                end(expr);
+                for (ExpressionNode* e : cast<BlockNode>(expr)->get_expressions()) {
+                    write_expression(e, id);
+                }
+                break;
+
+            case NodeType::LetNodeType: {
+                // all initializers are children of the let, followed by the body
+                LetNode* let = cast<LetNode>(expr);
+                end(expr);
+                for (LetInitializerNode* init : let->get_initializers()) {
+                    write_expression(init, id);
+                }
+                write_expression(let->get_body(), id);
+                break;
+            }
+
+            case NodeType::LetInitializerType: {
+                LetInitializerNode* init = cast<LetInitializerNode>(expr);
+                field("name", init->get_name());
+                field("declared_type", init->get_type());
+                end(expr);
+                write_expression(init->get_expr(), id);
+                break;
+            }
+
+            case NodeType::CaseNodeType: {
+                CaseNode* case_node = cast<CaseNode>(expr);
+                end(expr);
+                write_expression(case_node->get_target(), id);
+                for (CaseBranchNode* branch : case_node->get_branches()) {
+                    uint branch_id = begin(branch, id);
+                    field("name", branch->get_name());
+                    field("declared_type", branch->get_type());
+                    end(branch);
+                    write_expression(branch->get_expr(), branch_id);
+                }
+                break;
+            }
+
+            case NodeType::DispatchNodeType: {
+                DispatchNode* dispatch = cast<DispatchNode>(expr);
+                field("method", dispatch->get_method_name());
+                end(expr);
+                write_expression(dispatch->get_object(), id);
+                for (ExpressionNode* parameter : dispatch->get_parameters()) {
+                    write_expression(parameter, id);
+                }
+                break;
+            }
+
+            case NodeType::StaticDispatchNodeType: {
+                StaticDispatchNode* dispatch = cast<StaticDispatchNode>(expr);
+                field("method", dispatch->get_method_name());
+                field("static_type", dispatch->get_static_type());
+                end(expr);
+                write_expression(dispatch->get_object(), id);
+                for (ExpressionNode* parameter : dispatch->get_parameters()) {
+                    write_expression(parameter, id);
+                }
+                break;
+            }
+
+            default:
+                end(expr);
+                break;
+        }
+    });
+}
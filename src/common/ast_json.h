@@ -0,0 +1,43 @@
+#ifndef AST_JSON_H
+#define AST_JSON_H
+
+#include <string_view>
+#include "ast.h"
+#include "../utils/writer.h"
+#include "../utils/pretty_print.h"
+#include "../utils/stack_segments.h"
+
+/*
+ *  JSON lines dump of the abstract syntax tree, for tools that post-process it.
+ *
+ *  Every node is written on a line of its own as a JSON object with an "id",
+ *  the "id" of its "parent", its kind ("node") and its "line", followed by
+ *  the fields of the node. Expressions also carry their checked "type".
+ *  Nodes are written in pre-order, so the children of a node follow it in
+ *  the same order as in the text dump. The formals of a method are written
+ *  as children of the method.
+ */
+
+class AstJson {
+    private:
+        Writer& out;
+        uint next_id = 0;
+
+        // writes the fields shared by all nodes and leaves the object open
+        uint begin(Node*, uint parent);
+        void end(Node*);
+
+        void field(std::string_view name, Symbol);
+        void field(std::string_view name, std::string_view);
+
+        void write_class(ClassNode*, uint parent);
+        void write_feature(FeatureNode*, uint parent);
+        void write_expression(ExpressionNode*, uint parent);
+
+    public:
+        AstJson(Writer& out) : out(out) {}
+
+        void write(ProgramNode&);
+};
+
+#endif
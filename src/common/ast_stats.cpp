@@ -0,0 +1,213 @@
+#include "ast_stats.h"
+
+/*
+ *  Statistics on the size of the abstract syntax tree, reported by --stats.
+ */
+
+AstStats::AstStats(ProgramNode& program) {
+    std::vector<ClassNode*> classes = program.get_classes();
+    add(&program, classes.capacity() * sizeof(ClassNode*));
+
+    for (ClassNode* cls : classes) {
+        visit_class(cls);
+    }
+
+    arena_bytes = program.get_arena().get_bytes_allocated();
+}
+
+void AstStats::visit_class(ClassNode* cls) {
+    // the features are also kept split into attributes and methods
+    add(cls, list_bytes(cls->get_features()) + list_bytes(cls->get_attributes()) + list_bytes(cls->get_methods()));
+
+    for (FeatureNode* feature : cls->get_features()) {
+        visit_feature(feature);
+    }
+}
+
+void AstStats::visit_feature(FeatureNode* feature) {
+    if (MethodNode* method = dyn_cast<MethodNode>(feature)) {
+        add(method);
+
+        FormalsNode* formals = method->get_formals();
+        add(formals, list_bytes(formals->get_formals()));
+        for (FormalNode* formal : formals->get_formals()) {
+            add(formal);
+        }
+    } else {
+        add(cast<AttributeNode>(feature));
+    }
+
+    visit_expression(feature->get_expr());
+}
+
+void AstStats::visit_expression(ExpressionNode* expr) {
+    // nested expressions go through here, like typecheck and code
+    StackSegments::nested([&] {
+        switch (expr->get_node_type()) {
+            case NodeType::NoExpressionNodeType:
+                add(cast<NoExpressionNode>(expr));
+                break;
+
+            case NodeType::IntNodeType: {
+                IntNode* integer = cast<IntNode>(expr);
+                add(integer, integer->get_value().size());
+                break;
+            }
+
+            case NodeType::StringNodeType: {
+                StringNode* string = cast<StringNode>(expr);
+                add(string, string->get_value().size());
+                break;
+            }
+
+            case NodeType::BoolNodeType:
+                add(cast<BoolNode>(expr));
+                break;
+
+            case NodeType::IdentifierNodeType:
+                add(cast<IdentifierNode>(expr));
+                break;
+
+            case NodeType::AssignmentNodeType: {
+                AssignmentNode* assign = cast<AssignmentNode>(expr);
+                add(assign);
+                visit_expression(assign->get_expr());
+                break;
+            }
+
+            case NodeType::NewNodeType:
+                add(cast<NewNode>(expr));
+                break;
+
+            case NodeType::IsvoidNodeType:
+            case NodeType::NegNodeType:
+            case NodeType::ComplementNodeType: {
+                // the operators add no fields to their base class
+                UnaryOperationNode* op = cast<UnaryOperationNode>(expr);
+                add(op);
+                visit_expression(op->get_expr());
+                break;
+            }
+
+            case NodeType::PlusNodeType:
+            case NodeType::MinusNodeType:
+            case NodeType::MultiplicationNodeType:
+            case NodeType::DivisionNodeType:
+            case NodeType::LTNodeType:
+            case NodeType::LTENodeType:
+            case NodeType::EQNodeType: {
+                BinaryOperationNode* op = cast<BinaryOperationNode>(expr);
+                add(op);
+                visit_expression(op->get_first());
+                visit_expression(op->get_second());
+                break;
+            }
+
+            case NodeType::ConditionalNodeType: {
+                ConditionalNode* cond = cast<ConditionalNode>(expr);
+                add(cond);
+                visit_expression(cond->get_predicate());
+                visit_expression(cond->get_then());
+                visit_expression(cond->get_else());
+                break;
+            }
+
+            case NodeType::WhileNodeType: {
+                WhileNode* loop = cast<WhileNode>(expr);
+                add(loop);
+                visit_expression(loop->get_predicate());
+                visit_expression(loop->get_body());
+                break;
+            }
+
+            case NodeType::BlockNodeType: {
+                BlockNode* block = cast<BlockNode>(expr);
+                add(block, list_bytes(block->get_expressions()));
+                for (ExpressionNode* e : block->get_expressions()) {
+                    visit_expression(e);
+                }
+                break;
+            }
+
+            case NodeType::LetNodeType: {
+                LetNode* let = cast<LetNode>(expr);
+                add(let, list_bytes(let->get_initializers()));
+                for (LetInitializerNode* init : let->get_initializers()) {
+                    visit_expression(init);
+                }
+                visit_expression(let->get_body());
+                break;
+            }
+
+            case NodeType::LetInitializerType: {
+                LetInitializerNode* init = cast<LetInitializerNode>(expr);
+                add(init);
+                visit_expression(init->get_expr());
+                break;
+            }
+
+            case NodeType::CaseNodeType: {
+                CaseNode* case_node = cast<CaseNode>(expr);
+                add(case_node, list_bytes(case_node->get_branches()));
+                visit_expression(case_node->get_target());
+                for (CaseBranchNode* branch : case_node->get_branches()) {
+                    add(branch);
+                    visit_expression(branch->get_expr());
+                }
+                break;
+            }
+
+            case NodeType::DispatchNodeType: {
+                DispatchNode* dispatch = cast<DispatchNode>(expr);
+                add(dispatch, list_bytes(dispatch->get_parameters()));
+                visit_expression(dispatch->get_object());
+                for (ExpressionNode* parameter : dispatch->get_parameters()) {
+                    visit_expression(parameter);
+                }
+                break;
+            }
+
+            case NodeType::StaticDispatchNodeType: {
+                StaticDispatchNode* dispatch = cast<StaticDispatchNode>(expr);
+                add(dispatch, list_bytes(dispatch->get_parameters()));
+                visit_expression(dispatch->get_object());
+                for (ExpressionNode* parameter : dispatch->get_parameters()) {
+                    visit_expression(parameter);
+                }
+                break;
+            }
+
+            default:
+                break;
+        }
+    });
+}
+
+size_t AstStats::get_node_count() const {
+    size_t count = 0;
+    for (const Kind& kind : kinds) {
+        count += kind.count;
+    }
+    return count;
+}
+
+void AstStats::write_json(Writer& out) {
+    size_t total_count = 0;
+    size_t total_bytes = 0;
+
+    out << "{\"by_type\":{";
+    for (size_t type = 0; type < kinds.size(); ++type) {
+        const Kind& kind = kinds[type];
+        if (kind.count == 0) {
+            continue;
+        }
+
+        out << (total_count > 0 ? "," : "") << '"' << get_node_type_name(static_cast<NodeType>(type))
+            << "\":{\"count\":" << kind.count << ",\"bytes\":" << kind.bytes << '}';
+
+        total_count += kind.count;
+        total_bytes += kind.bytes;
+    }
+
+    out << "},\"count\":" << total_count << ",\"bytes\":" << total_bytes << ",\"arena_bytes\":" << arena_bytes << '}';
+}
@@ -0,0 +1,53 @@
+#ifndef AST_STATS_H
+#define AST_STATS_H
+
+#include <array>
+#include "ast.h"
+#include "../utils/writer.h"
+#include "../utils/stack_segments.h"
+
+/*
+ *  Memory used by the abstract syntax tree.
+ *
+ *  Counts the nodes of a program by NodeType along with the bytes they take
+ *  up: the node itself, the arena storage of its child lists and, for integer
+ *  and string literals, the characters of the literal.
+ */
+
+class AstStats {
+    private:
+        struct Kind {
+            size_t count = 0;
+            size_t bytes = 0;
+        };
+
+        std::array<Kind, NodeType::NodeTypeCount> kinds;
+        size_t arena_bytes = 0;
+
+        template <typename T>
+        void add(T* node, size_t extra_bytes = 0) {
+            Kind& kind = kinds[node->get_node_type()];
+            kind.count++;
+            kind.bytes += sizeof(T) + extra_bytes;
+        }
+
+        template <typename T>
+        static size_t list_bytes(NodeList<T> list) {
+            return list.size() * sizeof(T);
+        }
+
+        void visit_class(ClassNode*);
+        void visit_feature(FeatureNode*);
+        void visit_expression(ExpressionNode*);
+
+    public:
+        AstStats(ProgramNode&);
+
+        // the number of nodes of all kinds
+        size_t get_node_count() const;
+
+        // a JSON object with the nodes of each kind and their totals
+        void write_json(Writer&);
+};
+
+#endif
@@ -0,0 +1,104 @@
+#include "class_layout.h"
+
+/*
+ *  Computes the layout of all classes once, after semantic analysis.
+ */
+
+ClassLayout::ClassLayout(ClassTable& classtable) : classtable(classtable) {
+    size_t count = classtable.get_class_count();
+    attribute_offsets.assign(count + 1, 0);
+    slot_offsets.assign(count + 1, 0);
+
+    // a class has at most the slots of its parent and one for each of its
+    // methods, reserving for that keeps the tables from growing step by step
+    std::vector<size_t> slot_bounds(count, 0);
+    size_t total_slots = 0;
+    for (ClassId id = 0; id < count; ++id) {
+        ClassNode* cls = classtable.get_class(id);
+        slot_bounds[id] = (id > 0 ? slot_bounds[classtable.get_parent(id)] : 0) + cls->get_methods().size();
+        total_slots += slot_bounds[id];
+    }
+    slots.reserve(total_slots);
+    method_slots.reserve(total_slots);
+
+    // parents are numbered before their children, so the layout of the
+    // parent of a class is complete by the time the class is reached
+    for (ClassId id = 0; id < count; ++id) {
+        ClassNode* cls = classtable.get_class(id);
+        size_t first_attribute = attributes.size();
+        size_t first_slot = slots.size();
+
+        if (id > 0) {
+            ClassId parent = classtable.get_parent(id);
+            for (size_t i = attribute_offsets[parent]; i < attribute_offsets[parent + 1]; ++i) {
+                attributes.push_back(attributes[i]);
+            }
+            for (size_t i = slot_offsets[parent]; i < slot_offsets[parent + 1]; ++i) {
+                Slot slot = slots[i];
+                slots.push_back(slot);
+            }
+        }
+
+        for (AttributeNode* attr : cls->get_attributes()) {
+            // inherited attributes cannot be redefined - no need to check for overriding
+            attribute_indices[key(id, attr->get_name())] = attributes.size() - first_attribute;
+            attributes.push_back(attr);
+        }
+
+        for (MethodNode* method : cls->get_methods()) {
+            // an overriding method takes over the slot of the method it overrides
+            auto it = id > 0 ? method_slots.find(key(classtable.get_parent(id), method->get_name())) : method_slots.end();
+            if (it != method_slots.end()) {
+                slots[first_slot + it->second] = { cls->get_name(), method->get_name() };
+            } else {
+                slots.push_back({ cls->get_name(), method->get_name() });
+            }
+        }
+
+        for (size_t i = first_slot; i < slots.size(); ++i) {
+            method_slots[key(id, slots[i].method)] = i - first_slot;
+        }
+
+        attribute_offsets[id + 1] = attributes.size();
+        slot_offsets[id + 1] = slots.size();
+    }
+}
+
+ClassId ClassLayout::get_id(Symbol cls) {
+    ClassId id = classtable.get_id(cls);
+    if (id >= classtable.get_class_count()) {
+        throw std::logic_error("Error: Requested class has no layout.");
+    }
+    return id;
+}
+
+Span<AttributeNode*> ClassLayout::get_attributes(Symbol cls) {
+    ClassId id = get_id(cls);
+    return Span<AttributeNode*>(attributes.data() + attribute_offsets[id], attribute_offsets[id + 1] - attribute_offsets[id]);
+}
+
+Span<ClassLayout::Slot> ClassLayout::get_dispatch_table(Symbol cls) {
+    ClassId id = get_id(cls);
+    return Span<Slot>(slots.data() + slot_offsets[id], slot_offsets[id + 1] - slot_offsets[id]);
+}
+
+uint ClassLayout::get_object_size(Symbol cls) {
+    return get_attribute_offset(get_attributes(cls).size());
+}
+
+uint ClassLayout::get_attribute_offset(Symbol cls, Symbol attribute) {
+    auto it = attribute_indices.find(key(get_id(cls), attribute));
+    if (it == attribute_indices.end()) {
+        throw std::logic_error("Error: Requested attribute not found in class.");
+    }
+    return get_attribute_offset(it->second);
+}
+
+uint ClassLayout::get_method_offset(Symbol cls, Symbol method) {
+    // the first slot of every dispatch table is the initializer
+    auto it = method_slots.find(key(get_id(cls), method));
+    if (it == method_slots.end()) {
+        throw std::logic_error("Error: Requested method not found in dispatch table.");
+    }
+    return Constants::WordSize * (it->second + 1);
+}
@@ -0,0 +1,78 @@
+#ifndef CLASS_LAYOUT_H
+#define CLASS_LAYOUT_H
+
+#include <unordered_map>
+#include <vector>
+#include <stdexcept>
+#include <cstdint>
+#include "ast.h"
+#include "classtable.h"
+#include "../common/consts.h"
+#include "../common/symbol.h"
+#include "../utils/span.h"
+
+/*
+ *  Run-time layout of the objects and dispatch tables of every class.
+ *
+ *  Objects start with NumObjHeaders words of headers, followed by the
+ *  attributes of the class, inherited attributes first. Dispatch tables
+ *  start with the initializer of the class, followed by one slot per method:
+ *  a class inherits the slots of its parent and either overrides a slot or
+ *  appends a new one for each method it defines.
+ */
+
+class ClassLayout {
+    public:
+        // a dispatch table entry: a method and the class that defines it
+        struct Slot {
+            Symbol cls;
+            Symbol method;
+        };
+
+    private:
+        ClassTable& classtable;
+
+        // the attributes and the dispatch table of every class,
+        // stored back to back and indexed by class ID
+        std::vector<AttributeNode*> attributes;
+        std::vector<size_t> attribute_offsets;
+        std::vector<Slot> slots;
+        std::vector<size_t> slot_offsets;
+
+        // the position of an attribute by the class that declares it,
+        // and the slot of a method by every class that has it,
+        // keyed by the class ID and the symbol ID of the feature
+        std::unordered_map<uint64_t, uint> attribute_indices;
+        std::unordered_map<uint64_t, uint> method_slots;
+
+        static uint64_t key(ClassId cls, Symbol feature) {
+            return (uint64_t(cls) << 32) | feature.get_id();
+        }
+
+        ClassId get_id(Symbol);
+
+    public:
+        ClassLayout(ClassTable&);
+
+        // the attributes of a class in the order they are laid out in its objects
+        Span<AttributeNode*> get_attributes(Symbol);
+
+        // the entries of the dispatch table of a class after its initializer
+        Span<Slot> get_dispatch_table(Symbol);
+
+        // size of the objects of a class in bytes, headers included
+        uint get_object_size(Symbol);
+
+        // offset in bytes of the nth attribute of an object
+        static uint get_attribute_offset(size_t index) {
+            return Constants::WordSize * (Constants::NumObjHeaders + index);
+        }
+
+        // offset in bytes of an attribute, given the class that declares it
+        uint get_attribute_offset(Symbol cls, Symbol attribute);
+
+        // offset in bytes of a method in the dispatch table of a class
+        uint get_method_offset(Symbol cls, Symbol method);
+};
+
+#endif
@@ -8,148 +8,157 @@
 
 static std::ostringstream error_msg;
 
-void ClassTable::install_basic_classes() {
+void ClassTable::install_basic_classes(Arena& arena) {
     // Object class
-    ClassNode* object_class = new ClassNode(Strings::Types::Object);
-    MethodNode* abort = new MethodNode(Strings::Methods::Abort);
-    abort->set_formals(new FormalsNode());
-    abort->set_type(Strings::Types::Object);
-    MethodNode* type_name = new MethodNode(Strings::Methods::TypeName);
-    type_name->set_formals(new FormalsNode());
-    type_name->set_type(Strings::Types::String);
-    MethodNode* copy = new MethodNode(Strings::Methods::Copy);
-    copy->set_formals(new FormalsNode());
-    copy->set_type(Strings::Types::SelfType);
-    object_class->add_method(abort);
-    object_class->add_method(type_name);
-    object_class->add_method(copy);
+    ClassNode* object_class = arena.make<ClassNode>(Symbols::Types::Object);
+    MethodNode* abort = arena.make<MethodNode>(Symbols::Methods::Abort);
+    abort->set_formals(arena.make<FormalsNode>());
+    abort->set_type(Symbols::Types::Object);
+    MethodNode* type_name = arena.make<MethodNode>(Symbols::Methods::TypeName);
+    type_name->set_formals(arena.make<FormalsNode>());
+    type_name->set_type(Symbols::Types::String);
+    MethodNode* copy = arena.make<MethodNode>(Symbols::Methods::Copy);
+    copy->set_formals(arena.make<FormalsNode>());
+    copy->set_type(Symbols::Types::SelfType);
+    object_class->set_features(arena, NodeList<FeatureNode*>(arena, { abort, type_name, copy }));
 
     // IO class
-    ClassNode* io_class = new ClassNode(Strings::Types::IO);
-    MethodNode* out_string = new MethodNode(Strings::Methods::OutString);
-    FormalsNode* out_string_formals = new FormalsNode();
-    out_string_formals->add_formal(new FormalNode(Strings::Parameters::Arg, Strings::Types::String));
+    ClassNode* io_class = arena.make<ClassNode>(Symbols::Types::IO);
+    MethodNode* out_string = arena.make<MethodNode>(Symbols::Methods::OutString);
+    FormalsNode* out_string_formals = arena.make<FormalsNode>();
+    out_string_formals->set_formals(NodeList<FormalNode*>(arena, { arena.make<FormalNode>(Symbols::Parameters::Arg, Symbols::Types::String) }));
     out_string->set_formals(out_string_formals);
-    out_string->set_type(Strings::Types::SelfType);
-    MethodNode* out_int = new MethodNode(Strings::Methods::OutInt);
-    FormalsNode* out_int_formals = new FormalsNode();
-    out_int_formals->add_formal(new FormalNode(Strings::Parameters::Arg, Strings::Types::Int));
+    out_string->set_type(Symbols::Types::SelfType);
+    MethodNode* out_int = arena.make<MethodNode>(Symbols::Methods::OutInt);
+    FormalsNode* out_int_formals = arena.make<FormalsNode>();
+    out_int_formals->set_formals(NodeList<FormalNode*>(arena, { arena.make<FormalNode>(Symbols::Parameters::Arg, Symbols::Types::Int) }));
     out_int->set_formals(out_int_formals);
-    out_int->set_type(Strings::Types::SelfType);
-    MethodNode* in_string = new MethodNode(Strings::Methods::InString);
-    in_string->set_formals(new FormalsNode());
-    in_string->set_type(Strings::Types::String);
-    MethodNode* in_int = new MethodNode(Strings::Methods::InInt);
-    in_int->set_formals(new FormalsNode());
-    in_int->set_type(Strings::Types::Int);
-    io_class->set_base_class(Strings::Types::Object);
-    io_class->add_method(out_string);
-    io_class->add_method(out_int);
-    io_class->add_method(in_string);
-    io_class->add_method(in_int);
+    out_int->set_type(Symbols::Types::SelfType);
+    MethodNode* in_string = arena.make<MethodNode>(Symbols::Methods::InString);
+    in_string->set_formals(arena.make<FormalsNode>());
+    in_string->set_type(Symbols::Types::String);
+    MethodNode* in_int = arena.make<MethodNode>(Symbols::Methods::InInt);
+    in_int->set_formals(arena.make<FormalsNode>());
+    in_int->set_type(Symbols::Types::Int);
+    io_class->set_base_class(Symbols::Types::Object);
+    io_class->set_features(arena, NodeList<FeatureNode*>(arena, { out_string, out_int, in_string, in_int }));
 
     // Int class
-    ClassNode* int_class = new ClassNode(Strings::Types::Int);
-    AttributeNode* int_val = new AttributeNode(Strings::Attributes::Val);
-    int_val->set_type(Strings::Types::PrimSlot);
-    int_class->set_base_class(Strings::Types::Object);
-    int_class->add_attribute(int_val);
+    ClassNode* int_class = arena.make<ClassNode>(Symbols::Types::Int);
+    AttributeNode* int_val = arena.make<AttributeNode>(Symbols::Attributes::Val);
+    int_val->set_type(Symbols::Types::PrimSlot);
+    int_class->set_base_class(Symbols::Types::Object);
+    int_class->set_features(arena, NodeList<FeatureNode*>(arena, { int_val }));
 
     // Bool class
-    ClassNode* bool_class = new ClassNode(Strings::Types::Bool);
-    AttributeNode* bool_val = new AttributeNode(Strings::Attributes::Val);
-    bool_val->set_type(Strings::Types::PrimSlot);
-    bool_class->set_base_class(Strings::Types::Object);
-    bool_class->add_attribute(bool_val);
+    ClassNode* bool_class = arena.make<ClassNode>(Symbols::Types::Bool);
+    AttributeNode* bool_val = arena.make<AttributeNode>(Symbols::Attributes::Val);
+    bool_val->set_type(Symbols::Types::PrimSlot);
+    bool_class->set_base_class(Symbols::Types::Object);
+    bool_class->set_features(arena, NodeList<FeatureNode*>(arena, { bool_val }));
 
     // String class
-    ClassNode* string_class = new ClassNode(Strings::Types::String);
-    AttributeNode* str_val = new AttributeNode(Strings::Attributes::Val);
-    str_val->set_type(Strings::Types::Int);
-    AttributeNode* str_field = new AttributeNode(Strings::Attributes::StrField);
-    str_field->set_type(Strings::Types::PrimSlot);
-    MethodNode* length = new MethodNode(Strings::Methods::Length);
-    length->set_formals(new FormalsNode());
-    length->set_type(Strings::Types::Int);
-    MethodNode* concat = new MethodNode(Strings::Methods::Concat);
-    FormalsNode* concat_formals = new FormalsNode();
-    concat_formals->add_formal(new FormalNode(Strings::Parameters::Arg, Strings::Types::String));
+    ClassNode* string_class = arena.make<ClassNode>(Symbols::Types::String);
+    AttributeNode* str_val = arena.make<AttributeNode>(Symbols::Attributes::Val);
+    str_val->set_type(Symbols::Types::Int);
+    AttributeNode* str_field = arena.make<AttributeNode>(Symbols::Attributes::StrField);
+    str_field->set_type(Symbols::Types::PrimSlot);
+    MethodNode* length = arena.make<MethodNode>(Symbols::Methods::Length);
+    length->set_formals(arena.make<FormalsNode>());
+    length->set_type(Symbols::Types::Int);
+    MethodNode* concat = arena.make<MethodNode>(Symbols::Methods::Concat);
+    FormalsNode* concat_formals = arena.make<FormalsNode>();
+    concat_formals->set_formals(NodeList<FormalNode*>(arena, { arena.make<FormalNode>(Symbols::Parameters::Arg, Symbols::Types::String) }));
     concat->set_formals(concat_formals);
-    concat->set_type(Strings::Types::String);
-    MethodNode* substr = new MethodNode(Strings::Methods::Substr);
-    FormalsNode* substr_formals = new FormalsNode();
-    substr_formals->add_formal(new FormalNode(Strings::Parameters::Arg1, Strings::Types::Int));
-    substr_formals->add_formal(new FormalNode(Strings::Parameters::Arg2, Strings::Types::Int));
+    concat->set_type(Symbols::Types::String);
+    MethodNode* substr = arena.make<MethodNode>(Symbols::Methods::Substr);
+    FormalsNode* substr_formals = arena.make<FormalsNode>();
+    substr_formals->set_formals(NodeList<FormalNode*>(arena, { arena.make<FormalNode>(Symbols::Parameters::Arg1, Symbols::Types::Int),
+                                                               arena.make<FormalNode>(Symbols::Parameters::Arg2, Symbols::Types::Int) }));
     substr->set_formals(substr_formals);
-    substr->set_type(Strings::Types::String);
-    string_class->set_base_class(Strings::Types::Object);
-    string_class->add_attribute(str_val);
-    string_class->add_attribute(str_field);
-    string_class->add_method(length);
-    string_class->add_method(concat);
-    string_class->add_method(substr);
-
-    clsmap[Strings::Types::Object] = object_class;
-    clsmap[Strings::Types::IO] = io_class;
-    clsmap[Strings::Types::Int] = int_class;
-    clsmap[Strings::Types::Bool] = bool_class;
-    clsmap[Strings::Types::String] = string_class;
+    substr->set_type(Symbols::Types::String);
+    string_class->set_base_class(Symbols::Types::Object);
+    string_class->set_features(arena, NodeList<FeatureNode*>(arena, { str_val, str_field, length, concat, substr }));
+
+    add_class(object_class);
+    add_class(io_class);
+    add_class(int_class);
+    add_class(bool_class);
+    add_class(string_class);
 }
 
-ClassTable::ClassTable(std::vector<ClassNode*> classes) {
-    install_basic_classes();
+void ClassTable::add_class(ClassNode* cls) {
+    // classes are numbered in order of definition for now,
+    // and renumbered once the inheritance graph is known
+    uint symbol = cls->get_name().get_id();
+    if (symbol >= ids.size()) {
+        ids.resize(symbol + 1, NoClass);
+    }
+
+    ids[symbol] = nodes.size();
+    nodes.push_back(cls);
+    classes.push_back(cls);
+}
+
+ClassTable::ClassTable(std::vector<ClassNode*> program_classes, Arena& arena) {
+    // the basic classes are allocated alongside the program's own nodes
+    install_basic_classes(arena);
 
     // iterate over the classes, identifying multiply defined classes
     // add classes to a map, so we can find a class by symbol later
-    for (ClassNode* cls : classes) {
-        std::string name = cls->get_name();
-        std::string parent = cls->get_base_class();
+    for (ClassNode* cls : program_classes) {
+        Symbol name = cls->get_name();
+        Symbol parent = cls->get_base_class();
 
         // basic classes must not be redefined
-        if (name == Strings::Types::Int || name == Strings::Types::String || name == Strings::Types::Bool || name == Strings::Types::IO || name == Strings::Types::Object) {
+        if (name == Symbols::Types::Int || name == Symbols::Types::String || name == Symbols::Types::Bool || name == Symbols::Types::IO || name == Symbols::Types::Object) {
             error_msg << "Redefinition of basic class " << name << ".";
             semant_error(error_msg.str(), cls->get_line_number());
         }
 
         // special case: the SELF_TYPE class must not be redefined
-        if (name == Strings::Types::SelfType) {
+        if (name == Symbols::Types::SelfType) {
             error_msg << "Redefinition of basic class " << name << ".";
             semant_error(error_msg.str(), cls->get_line_number());
         };
 
         // classes must not be multiply defined
-        if (clsmap.find(name) != clsmap.end()) {
+        if (exists(name)) {
             error_msg << "Class " << name << " was previously defined.";
             semant_error(error_msg.str(), cls->get_line_number());
         }
 
         // it is an error to inherit from Int, Str and Bool
-        if (parent == Strings::Types::Int 
-            || parent == Strings::Types::String 
-            || parent == Strings::Types::Bool 
-            || parent == Strings::Types::SelfType
+        if (parent == Symbols::Types::Int 
+            || parent == Symbols::Types::String 
+            || parent == Symbols::Types::Bool 
+            || parent == Symbols::Types::SelfType
         ) {
             error_msg << "Class " << cls->get_name() << " cannot inherit class " << parent << ".";
             semant_error(error_msg.str(), cls->get_line_number());
         }
 
         // if we get this far, the class is fine and can be added to the map
-        clsmap[name] = cls;
+        add_class(cls);
     }
 
+    std::sort(classes.begin(), classes.end(), [](ClassNode* a, ClassNode* b) {
+        return a->get_name().str() < b->get_name().str();
+    });
+
     // the Main class must be defined
-    if (clsmap.find(Strings::Types::MainClass) == clsmap.end()) {
+    if (!exists(Symbols::Types::MainClass)) {
         semant_error("Class Main is not defined.");
     }
 
-    ClassNode* main_class = clsmap.find(Strings::Types::MainClass)->second;
+    ClassNode* main_class = find(Symbols::Types::MainClass);
 
     // verify that the Main class contains a method feature called "main"
     bool main_method_exists = false;
-    std::vector<MethodNode*> methods = main_class->get_methods();
+    NodeList<MethodNode*> methods = main_class->get_methods();
     
     for (MethodNode* method : methods) {
-        if (method->get_name() == Strings::Methods::MainMethod) {
+        if (method->get_name() == Symbols::Methods::MainMethod) {
             main_method_exists = true;
             break;
         }
@@ -166,24 +175,22 @@ ClassTable::ClassTable(std::vector<ClassNode*> classes) {
 }
 
 void ClassTable::check_inheritance_graph() {
-    // we don't have to actually "build" an inheritance graph;
-    // using the get_base_class method of the ClassNode object, we 
-    // already have an adjacency list representation
+    // the get_base_class method of the ClassNode objects already gives
+    // the parent links; the children are collected below for numbering
 
     // verify that all parent classes actually exists
-    for (auto iter = clsmap.begin(); iter != clsmap.end(); ++iter) {
-        std::string name = iter->first;
-        ClassNode* cls = iter->second;
+    for (ClassNode* cls : classes) {
+        Symbol name = cls->get_name();
 
-        if (name == Strings::Types::Object) {
+        if (name == Symbols::Types::Object) {
             // the Object class is the root, so this test
             // doesn't apply to it
             continue;
         }
 
-        std::string parent = cls->get_base_class();
+        Symbol parent = cls->get_base_class();
 
-        if (clsmap.find(parent) == clsmap.end()) {
+        if (!exists(parent)) {
             // the parent class is not defined
             error_msg << "Class " << name
                       << " inherits from an undefined class " << parent << ".";
@@ -191,74 +198,226 @@ void ClassTable::check_inheritance_graph() {
         }
     }
 
-    // check for cycles in the inheritance graph
-    for (auto iter = clsmap.begin(); iter != clsmap.end(); ++iter) {
-        std::string name = iter->first;
-        ClassNode* cls = iter->second;
+    // number the classes from Object downwards, visiting
+    // the children of each class in order of their names
+    std::vector<std::vector<ClassId>> children(nodes.size());
+    for (ClassNode* cls : classes) {
+        if (cls->get_name() != Symbols::Types::Object) {
+            children[get_id(cls->get_base_class())].push_back(get_id(cls->get_name()));
+        }
+    }
+
+    std::vector<ClassId> order = { get_id(Symbols::Types::Object) };
+    for (size_t i = 0; i < order.size(); ++i) {
+        for (ClassId child : children[order[i]]) {
+            order.push_back(child);
+        }
+    }
 
-        std::string ancestor_symbol = name;
-        ClassNode* ancestor_class = cls;
+    // classes that cannot be reached from Object are part of a cycle in
+    // the inheritance graph or inherit from one. every class has a single
+    // parent, so following the parents of such a class ends up going around
+    // a cycle, which is marked in the walk that closes it
+    if (order.size() < nodes.size()) {
+        const uint reached = ~0u;
+        std::vector<uint> walks(nodes.size(), 0);
+        std::vector<bool> on_cycle(nodes.size(), false);
+        for (ClassId id : order) {
+            walks[id] = reached;
+        }
 
-        while (ancestor_symbol != Strings::Types::Object) {
-            ancestor_symbol = ancestor_class->get_base_class();
+        uint walk = 0;
+        for (ClassNode* cls : classes) {
+            ClassId id = get_id(cls->get_name());
+            if (walks[id] != 0) {
+                continue;
+            }
 
-            // if we find an ancestor that matches the name
-            // of the original class, we have a cycle
-            if (ancestor_symbol == name) {
-                error_msg << "Class " << name << " directly or indirectly inherits from itself.";
-                semant_error(error_msg.str(), cls->get_line_number());
+            ++walk;
+            while (walks[id] == 0) {
+                walks[id] = walk;
+                id = get_id(nodes[id]->get_base_class());
             }
 
-            ancestor_class = clsmap[ancestor_symbol];
+            if (walks[id] == walk) {
+                ClassId start = id;
+                do {
+                    on_cycle[id] = true;
+                    id = get_id(nodes[id]->get_base_class());
+                } while (id != start);
+            }
+        }
+
+        // report the first class by name that is part of a cycle
+        for (ClassNode* cls : classes) {
+            if (on_cycle[get_id(cls->get_name())]) {
+                error_msg << "Class " << cls->get_name() << " directly or indirectly inherits from itself.";
+                semant_error(error_msg.str(), cls->get_line_number());
+            }
         }
     }
+
+    number_classes(order);
 }
 
-bool ClassTable::exists(const std::string& cls) {
-    return clsmap.find(cls) != clsmap.end();
+void ClassTable::number_classes(const std::vector<ClassId>& order) {
+    std::vector<ClassNode*> numbered;
+    for (ClassId id : order) {
+        numbered.push_back(nodes[id]);
+    }
+    nodes = std::move(numbered);
+
+    size_t count = nodes.size();
+    for (ClassId id = 0; id < count; ++id) {
+        ids[nodes[id]->get_name().get_id()] = id;
+    }
+
+    // parents are numbered before their children, so everything
+    // about the parent of a class is known by the time it is reached
+    parents.assign(count, NoClass);
+    depths.assign(count, 0);
+    ancestry_offsets.assign(count, 0);
+
+    size_t total = 0;
+    for (ClassId id = 0; id < count; ++id) {
+        if (id > 0) {
+            parents[id] = get_id(nodes[id]->get_base_class());
+            depths[id] = depths[parents[id]] + 1;
+        }
+        ancestry_offsets[id] = total;
+        total += depths[id] + 1;
+    }
+
+    // the ancestry of a class is the class itself followed by the ancestry of its parent
+    ancestries.resize(total);
+    for (ClassId id = 0; id < count; ++id) {
+        Symbol* ancestry = &ancestries[ancestry_offsets[id]];
+        ancestry[0] = nodes[id]->get_name();
+        if (id > 0) {
+            Span<Symbol> inherited = get_ancestry(nodes[parents[id]]->get_name());
+            std::copy(inherited.begin(), inherited.end(), ancestry + 1);
+        }
+    }
+
+    index_hierarchy();
 }
 
-// helper method for getting all parents of a class
-std::vector<std::string> ClassTable::get_ancestry(const std::string& cls) {
-    std::vector<std::string> ancestry;
+void ClassTable::index_hierarchy() {
+    size_t count = nodes.size();
 
-    std::string node = cls;
-    while (node != Strings::Types::Object) {
-        ancestry.push_back(node);
-        node = clsmap[node]->get_base_class();
+    // children are numbered after their parents, so going backwards
+    // every subtree is complete before it is added to its parent
+    std::vector<uint> subtree_sizes(count, 1);
+    for (ClassId id = count - 1; id > 0; --id) {
+        subtree_sizes[parents[id]] += subtree_sizes[id];
     }
 
-    ancestry.push_back(Strings::Types::Object);
+    // each class takes the next free position within the subtree of its parent
+    std::vector<uint> next_free(count);
+    preorder.assign(count, 0);
+    subtree_ends.assign(count, 0);
+    for (ClassId id = 0; id < count; ++id) {
+        if (id > 0) {
+            preorder[id] = next_free[parents[id]];
+            next_free[parents[id]] += subtree_sizes[id];
+        }
+        next_free[id] = preorder[id] + 1;
+        subtree_ends[id] = preorder[id] + subtree_sizes[id];
+    }
+
+    uint max_depth = *std::max_element(depths.begin(), depths.end());
+    levels = 1;
+    while ((1u << levels) <= max_depth) {
+        ++levels;
+    }
+
+    jumps.assign(levels * count, 0);
+    for (ClassId id = 1; id < count; ++id) {
+        jumps[id] = parents[id];
+    }
+    for (uint level = 1; level < levels; ++level) {
+        for (ClassId id = 0; id < count; ++id) {
+            jumps[level * count + id] = jump(level - 1, jump(level - 1, id));
+        }
+    }
+}
 
-    return ancestry;
+ClassNode* ClassTable::find(Symbol cls) {
+    ClassId id = get_id(cls);
+    return id != NoClass ? nodes[id] : nullptr;
 }
 
-// simple LUB implementation: get ancestry for both classes
-// and return the first class present in both ancestries 
-std::string ClassTable::least_upper_bound(const std::string& a, const std::string& b) {
-    std::vector<std::string> ancestry_a = get_ancestry(a);
-    std::vector<std::string> ancestry_b = get_ancestry(b);
+const std::vector<ClassNode*>& ClassTable::get_classes() {
+    return classes;
+}
 
-    for (size_t i = 0; i < ancestry_a.size(); ++i) {
-        for (size_t j = 0; j < ancestry_b.size(); ++j) {
-            if (ancestry_a[i] == ancestry_b[j]) {
-                return ancestry_a[i];
-            }
+bool ClassTable::exists(Symbol cls) {
+    return get_id(cls) != NoClass;
+}
+
+Span<Symbol> ClassTable::get_ancestry(Symbol cls) {
+    ClassId id = get_id(cls);
+    return Span<Symbol>(ancestries.data() + ancestry_offsets[id], depths[id] + 1);
+}
+
+bool ClassTable::conforms(Symbol a, Symbol b) {
+    if (b == Symbols::Types::Object) {
+        return true;
+    }
+
+    ClassId x = get_id(a);
+    ClassId y = get_id(b);
+    return x != NoClass && y != NoClass && descends(x, y);
+}
+
+// the least upper bound is the deepest common ancestor: bring both classes
+// to the same depth, then move both up by the largest jumps that keep them
+// apart, after which their parent is the common ancestor
+Symbol ClassTable::least_upper_bound(Symbol a, Symbol b) {
+    ClassId x = get_id(a);
+    ClassId y = get_id(b);
+
+    if (x == NoClass || y == NoClass) {
+        return Symbols::Types::Object;
+    }
+
+    if (descends(x, y)) {
+        return b;
+    }
+
+    if (descends(y, x)) {
+        return a;
+    }
+
+    if (depths[x] < depths[y]) {
+        std::swap(x, y);
+    }
+
+    uint difference = depths[x] - depths[y];
+    for (uint level = 0; difference != 0; ++level, difference >>= 1) {
+        if (difference & 1) {
+            x = jump(level, x);
         }
     }
 
-    // if nothing else, we know that the two classes
-    // must both be a child of Object
-    return Strings::Types::Object;
+    for (uint level = levels; level-- > 0;) {
+        if (jump(level, x) != jump(level, y)) {
+            x = jump(level, x);
+            y = jump(level, y);
+        }
+    }
+
+    return nodes[parents[x]]->get_name();
 }
 
-// overloaded method for supporting vectors of arbitrary length 
-std::string ClassTable::least_upper_bound(std::vector<std::string> symbols) {
-    std::string lub = symbols[0];
+// overloaded method for supporting vectors of arbitrary length,
+// folding over the pairwise bound until it reaches Object
+Symbol ClassTable::least_upper_bound(const std::vector<Symbol>& symbols) {
+    Symbol lub = symbols[0];
 
-    for (size_t i = 0; i < symbols.size(); ++i) {
+    for (size_t i = 0; i < symbols.size() && lub != Symbols::Types::Object; ++i) {
         lub = least_upper_bound(lub, symbols[i]);
     }
 
     return lub;
-}
\ No newline at end of file
+}
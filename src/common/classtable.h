@@ -1,25 +1,101 @@
 #ifndef CLASSTABLE_H
 #define CLASSTABLE_H
 
-#include <map>
+#include <unordered_map>
 #include <vector>
+#include <algorithm>
 #include <sstream>
 #include "ast.h"
 #include "../common/consts.h"
+#include "../common/symbol.h"
 #include "../utils/errors.h"
+#include "../utils/span.h"
+
+// classes are numbered densely in topological order, parents before their
+// children, so that Object is always 0 and a class ID can index flat arrays
+typedef uint ClassId;
 
 class ClassTable {
     private:
-        void install_basic_classes();
+        static constexpr ClassId NoClass = ~0u;
+
+        // class IDs indexed by the ID of the class name
+        std::vector<ClassId> ids;
+
+        // the class, its parent and its depth below Object, indexed by class ID
+        std::vector<ClassNode*> nodes;
+        std::vector<ClassId> parents;
+        std::vector<uint> depths;
+
+        // the ancestry of every class, from the class itself up to Object,
+        // stored back to back and computed once the hierarchy is known
+        std::vector<Symbol> ancestries;
+        std::vector<size_t> ancestry_offsets;
+
+        // the classes in pre-order of the inheritance tree: the descendants
+        // of a class are the classes numbered from its position up to the end
+        // of its subtree, so conformance is two comparisons
+        std::vector<uint> preorder;
+        std::vector<uint> subtree_ends;
+
+        // the ancestor 2^k levels above each class, or Object if there is
+        // none, stored level after level for finding common ancestors
+        std::vector<ClassId> jumps;
+        uint levels = 0;
+
+        // all classes sorted by name, so that iterating
+        // over the classes is deterministic
+        std::vector<ClassNode*> classes;
+
+        void add_class(ClassNode*);
+        void install_basic_classes(Arena&);
         void check_inheritance_graph();
+        void number_classes(const std::vector<ClassId>& order);
+        void index_hierarchy();
+
+        ClassId jump(uint level, ClassId id) {
+            return jumps[level * nodes.size() + id];
+        }
+
+        bool descends(ClassId descendant, ClassId ancestor) {
+            return preorder[ancestor] <= preorder[descendant] && preorder[descendant] < subtree_ends[ancestor];
+        }
 
     public:
-        ClassTable(std::vector<ClassNode*>);
-        std::map<std::string, ClassNode*> clsmap;
-        std::vector<std::string> get_ancestry(const std::string&);
-        bool exists(const std::string&);
-        std::string least_upper_bound(const std::string&, const std::string&);
-        std::string least_upper_bound(std::vector<std::string>);
+        ClassTable(std::vector<ClassNode*>, Arena&);
+        ClassNode* find(Symbol);
+        const std::vector<ClassNode*>& get_classes();
+        bool exists(Symbol);
+
+        // NoClass for names that are not classes
+        ClassId get_id(Symbol name) {
+            return name.get_id() < ids.size() ? ids[name.get_id()] : NoClass;
+        }
+
+        size_t get_class_count() {
+            return nodes.size();
+        }
+
+        ClassNode* get_class(ClassId id) {
+            return nodes[id];
+        }
+
+        ClassId get_parent(ClassId id) {
+            return parents[id];
+        }
+
+        uint get_depth(ClassId id) {
+            return depths[id];
+        }
+
+        // the class followed by its ancestors, ending with Object
+        Span<Symbol> get_ancestry(Symbol);
+
+        // whether a class is the same as or inherits from another
+        bool conforms(Symbol, Symbol);
+
+        Symbol least_upper_bound(Symbol, Symbol);
+        Symbol least_upper_bound(const std::vector<Symbol>&);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,36 @@
+#include "compiler_stats.h"
+
+/*
+ *  Counters reported by --stats.
+ */
+
+CompilerStats::Counter CompilerStats::tokens;
+CompilerStats::Counter CompilerStats::classes;
+CompilerStats::Counter CompilerStats::methods;
+CompilerStats::Counter CompilerStats::instructions;
+CompilerStats::Counter CompilerStats::string_constants;
+
+static void write_counter(Writer& out, const char* name, const CompilerStats::Counter& counter) {
+    out << '"' << name << "\":{\"count\":" << counter.count << ",\"bytes\":" << counter.bytes << "},";
+}
+
+void CompilerStats::write_json(Writer& out, AstStats* ast_stats) {
+    out << '{';
+    write_counter(out, "tokens", tokens);
+
+    if (ast_stats) {
+        out << "\"nodes\":";
+        ast_stats->write_json(out);
+        out << ',';
+    }
+
+    write_counter(out, "classes", classes);
+    write_counter(out, "methods", methods);
+    write_counter(out, "instructions", instructions);
+    write_counter(out, "string_constants", string_constants);
+
+    // ru_maxrss is in kilobytes on Linux
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    out << "\"peak_rss_bytes\":" << size_t(usage.ru_maxrss) * 1024 << "}\n";
+}
@@ -0,0 +1,43 @@
+#ifndef COMPILER_STATS_H
+#define COMPILER_STATS_H
+
+#include <cstddef>
+#include <sys/resource.h>
+#include "ast_stats.h"
+#include "../utils/writer.h"
+
+/*
+ *  Sizes of what the compiler produced, for --stats.
+ *
+ *  The phases add to the counters as they go: the front end counts the
+ *  tokens, code generation the classes, methods, instructions and string
+ *  constants it emits. Phases that did not run report zeros.
+ */
+
+class CompilerStats {
+    public:
+        struct Counter {
+            size_t count = 0;
+            size_t bytes = 0;
+
+            void add(size_t size, size_t number = 1) {
+                count += number;
+                bytes += size;
+            }
+        };
+
+        // tokens in memory, classes by the size of their prototype and
+        // dispatch table, methods and instructions by the size of their
+        // assembly and string constants by the size of their value
+        static Counter tokens;
+        static Counter classes;
+        static Counter methods;
+        static Counter instructions;
+        static Counter string_constants;
+
+        // a single JSON object with all counters, the syntax tree if it
+        // was measured and the peak resident set size of the process
+        static void write_json(Writer&, AstStats*);
+};
+
+#endif
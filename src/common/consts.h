@@ -7,6 +7,16 @@ namespace Constants {
     constexpr int MaxStringSize = 1025;
     constexpr int NumObjHeaders = 5;
     constexpr int WordSize = 4;
+
+    // programs are only lexed in parallel if every chunk is at least this large
+    constexpr size_t MinLexChunkSize = 256 * 1024;
+
+    // deeply nested programs continue on a new stack after every
+    // StackSegmentDepth levels of nesting; one level takes a few
+    // hundred bytes, the segments are sized with a wide margin
+    constexpr uint StackSegmentDepth = 5000;
+    constexpr size_t StackBytesPerLevel = 4 * 1024;
+    constexpr size_t StackSegmentReserve = 1024 * 1024;
 }
 
 namespace Strings {
@@ -0,0 +1,77 @@
+#ifndef SCOPED_TABLE_H
+#define SCOPED_TABLE_H
+
+#include <vector>
+#include "symbol.h"
+
+/*
+ *  Symbol table with nested scopes.
+ *
+ *  The innermost binding of every symbol is kept in a flat array indexed by
+ *  the symbol ID, so looking up a name takes a single index. Adding a binding
+ *  logs the binding it hides, and leaving a scope undoes the log back to
+ *  where the scope was entered, so entering and leaving scopes allocates
+ *  nothing and costs only the bindings made inside the scope.
+ */
+
+template <typename T>
+class ScopedTable {
+    private:
+        struct Binding {
+            T value{};
+
+            // depth of the scope the binding was made in, 0 if unbound
+            uint scope = 0;
+        };
+
+        struct Undo {
+            uint symbol;
+            Binding previous;
+        };
+
+        std::vector<Binding> bindings;
+        std::vector<Undo> log;
+
+        // length of the log when each of the current scopes was entered
+        std::vector<size_t> marks;
+
+    public:
+        void enter_scope() {
+            marks.push_back(log.size());
+        }
+
+        void exit_scope() {
+            for (size_t mark = marks.back(); log.size() > mark; log.pop_back()) {
+                bindings[log.back().symbol] = log.back().previous;
+            }
+            marks.pop_back();
+        }
+
+        // binds a name in the innermost scope, hiding outer bindings of it
+        void add(Symbol name, T value) {
+            uint symbol = name.get_id();
+            if (symbol >= bindings.size()) {
+                bindings.resize(symbol + 1);
+            }
+
+            log.push_back({ symbol, bindings[symbol] });
+            bindings[symbol] = { value, static_cast<uint>(marks.size()) };
+        }
+
+        // the innermost binding of a name, nullptr if it is unbound
+        const T* lookup(Symbol name) const {
+            uint symbol = name.get_id();
+            if (symbol >= bindings.size() || bindings[symbol].scope == 0) {
+                return nullptr;
+            }
+            return &bindings[symbol].value;
+        }
+
+        // whether a name is bound in the innermost scope
+        bool probe(Symbol name) const {
+            uint symbol = name.get_id();
+            return symbol < bindings.size() && bindings[symbol].scope != 0 && bindings[symbol].scope == marks.size();
+        }
+};
+
+#endif
@@ -0,0 +1,95 @@
+#include "symbol.h"
+
+/*
+ *  The global symbol table.
+ */
+
+static SymbolTable& symbol_table() {
+    static SymbolTable table;
+    return table;
+}
+
+SymbolTable::SymbolTable() {
+    // the order must match the IDs in the Symbols namespace
+    for (const std::string& name : { std::string(""),
+                                     Strings::Self,
+                                     Strings::Types::Object,
+                                     Strings::Types::IO,
+                                     Strings::Types::Int,
+                                     Strings::Types::Bool,
+                                     Strings::Types::String,
+                                     Strings::Types::SelfType,
+                                     Strings::Types::NoType,
+                                     Strings::Types::PrimSlot,
+                                     Strings::Types::MainClass,
+                                     Strings::Methods::Abort,
+                                     Strings::Methods::TypeName,
+                                     Strings::Methods::Copy,
+                                     Strings::Methods::OutString,
+                                     Strings::Methods::OutInt,
+                                     Strings::Methods::InString,
+                                     Strings::Methods::InInt,
+                                     Strings::Methods::Length,
+                                     Strings::Methods::Concat,
+                                     Strings::Methods::Substr,
+                                     Strings::Methods::MainMethod,
+                                     Strings::Attributes::Val,
+                                     Strings::Attributes::StrField,
+                                     Strings::Parameters::Arg,
+                                     Strings::Parameters::Arg1,
+                                     Strings::Parameters::Arg2
+                                   }) {
+        intern(name);
+    }
+}
+
+SymbolTable::~SymbolTable() {
+    for (size_t i = 0; i < MaxChunks && chunks[i].load(); ++i) {
+        delete[] chunks[i].load();
+    }
+}
+
+Symbol SymbolTable::intern(std::string_view name) {
+    auto it = index.find(name);
+
+    if (it != index.end()) {
+        return Symbol(it->second);
+    }
+
+    uint id = count++;
+    size_t chunk = id >> ChunkBits;
+
+    if (chunk >= MaxChunks) {
+        throw std::length_error("Too many symbols.");
+    }
+
+    if (!chunks[chunk].load(std::memory_order_relaxed)) {
+        chunks[chunk].store(new std::string[ChunkSize], std::memory_order_release);
+    }
+
+    std::string& slot = chunks[chunk].load(std::memory_order_relaxed)[id & (ChunkSize - 1)];
+    slot = name;
+    index.emplace(slot, id);
+
+    return Symbol(id);
+}
+
+Symbol Symbol::intern(std::string_view name) {
+    return symbol_table().intern(name);
+}
+
+size_t Symbol::count() {
+    return symbol_table().size();
+}
+
+const std::string& Symbol::str() const {
+    return symbol_table().get_name(*this);
+}
+
+std::ostream& operator<<(std::ostream& os, Symbol s) {
+    return os << s.str();
+}
+
+Writer& operator<<(Writer& out, Symbol s) {
+    return out << s.str();
+}
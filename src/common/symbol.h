@@ -0,0 +1,141 @@
+#ifndef SYMBOL_H
+#define SYMBOL_H
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <atomic>
+#include <unordered_map>
+#include "consts.h"
+#include "../utils/writer.h"
+
+/*
+ *  Interned symbols.
+ *
+ *  Every identifier and type name is stored once in a global symbol table
+ *  and referred to by a dense integer ID, so later phases can compare and
+ *  hash symbols without touching the underlying strings.
+ */
+
+class Symbol {
+    private:
+        uint id;
+
+    public:
+        constexpr Symbol() : id(0) {}
+        constexpr explicit Symbol(uint i) : id(i) {}
+
+        // look up the symbol for a name, adding it to the table if needed
+        static Symbol intern(std::string_view);
+
+        // number of symbols in the table, useful for sizing dense arrays
+        static size_t count();
+
+        uint get_id() const {
+            return id;
+        }
+
+        const std::string& str() const;
+
+        bool empty() const {
+            return id == 0;
+        }
+
+        bool operator==(Symbol other) const {
+            return id == other.id;
+        }
+
+        bool operator!=(Symbol other) const {
+            return id != other.id;
+        }
+
+        bool operator<(Symbol other) const {
+            return id < other.id;
+        }
+};
+
+std::ostream& operator<<(std::ostream&, Symbol);
+Writer& operator<<(Writer&, Symbol);
+
+namespace std {
+    template<>
+    struct hash<Symbol> {
+        size_t operator()(Symbol s) const {
+            return s.get_id();
+        }
+    };
+}
+
+// the predefined symbols have fixed IDs, so they can be compared
+// against without a lookup. the symbol table interns the corresponding
+// strings in exactly this order when it is created
+namespace Symbols {
+    constexpr Symbol Empty(0);
+    constexpr Symbol Self(1);
+
+    namespace Types {
+        constexpr Symbol Object(2);
+        constexpr Symbol IO(3);
+        constexpr Symbol Int(4);
+        constexpr Symbol Bool(5);
+        constexpr Symbol String(6);
+        constexpr Symbol SelfType(7);
+        constexpr Symbol NoType(8);
+        constexpr Symbol PrimSlot(9);
+        constexpr Symbol MainClass(10);
+    }
+
+    namespace Methods {
+        constexpr Symbol Abort(11);
+        constexpr Symbol TypeName(12);
+        constexpr Symbol Copy(13);
+        constexpr Symbol OutString(14);
+        constexpr Symbol OutInt(15);
+        constexpr Symbol InString(16);
+        constexpr Symbol InInt(17);
+        constexpr Symbol Length(18);
+        constexpr Symbol Concat(19);
+        constexpr Symbol Substr(20);
+        constexpr Symbol MainMethod(21);
+    }
+
+    namespace Attributes {
+        constexpr Symbol Val(22);
+        constexpr Symbol StrField(23);
+    }
+
+    namespace Parameters {
+        constexpr Symbol Arg(24);
+        constexpr Symbol Arg1(25);
+        constexpr Symbol Arg2(26);
+    }
+}
+
+class SymbolTable {
+    private:
+        // names are stored in fixed-size chunks that never move, so the name of
+        // a symbol can be read while the lexer thread is interning new symbols
+        static constexpr size_t ChunkBits = 12;
+        static constexpr size_t ChunkSize = size_t(1) << ChunkBits;
+        static constexpr size_t MaxChunks = size_t(1) << 16;
+
+        std::atomic<std::string*> chunks[MaxChunks] = {};
+        size_t count = 0;
+        std::unordered_map<std::string_view, uint> index;
+
+    public:
+        SymbolTable();
+        ~SymbolTable();
+        Symbol intern(std::string_view);
+
+        const std::string& get_name(Symbol s) const {
+            uint id = s.get_id();
+            return chunks[id >> ChunkBits].load(std::memory_order_acquire)[id & (ChunkSize - 1)];
+        }
+
+        size_t size() const {
+            return count;
+        }
+};
+
+#endif
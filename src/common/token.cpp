@@ -4,64 +4,282 @@
  *  Tokenstream methods.
  */
 
-std::vector<std::shared_ptr<Token>> Tokenstream::get_tokens() {
-    return tokens;
+Tokenstream::Tokenstream(size_t window) {
+    // a bounded stream keeps a fixed window of tokens in ring buffers,
+    // so memory use does not grow with the size of the program
+    size_t capacity = 64;
+    while (capacity < window) {
+        capacity <<= 1;
+    }
+
+    tokens.resize(capacity);
+    lexemes.resize(capacity);
+    materialized_strings.resize(capacity);
+    error_messages.resize(capacity);
+    mask = capacity - 1;
+    bounded = true;
+}
+
+Tokenstream::~Tokenstream() {
+    close();
 }
 
-Token* Tokenstream::get() {
-    // get the next token and move the pointer
-    if (pointer < tokens.size()) {
-        return tokens[pointer++].get();
+void Tokenstream::stream(std::function<bool()> producer, bool threaded) {
+    pipe = std::make_unique<TokenPipe>();
+    pipe->producer = std::move(producer);
+    pipe->threaded = threaded;
+
+    if (threaded) {
+        pipe->worker = std::thread([this] {
+            TokenPipe& p = *pipe;
+            while (!p.cancelled.load(std::memory_order_relaxed) && p.producer()) {}
+            p.published.store(count, std::memory_order_release);
+            p.finished.store(true, std::memory_order_release);
+        });
     }
+}
 
-    return nullptr;
-};
+void Tokenstream::close() {
+    // stop the lexer thread, the tokens read so far stay valid
+    if (pipe && pipe->worker.joinable()) {
+        pipe->cancelled.store(true);
+        pipe->worker.join();
+    }
+    pipe.reset();
+}
+
+void Tokenstream::use_local_symbols() {
+    local_symbols = std::make_unique<LocalSymbols>();
+}
+
+void Tokenstream::join(const std::vector<Tokenstream*>& chunks, const std::vector<uint>& line_offsets) {
+    // identifiers of each chunk are interned in order of first occurrence,
+    // which gives them the same IDs as lexing the whole program at once
+    std::vector<std::vector<uint>> symbols(chunks.size());
+    std::vector<size_t> token_base(chunks.size()), lexeme_base(chunks.size()), error_base(chunks.size());
+
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        if (chunks[i]->local_symbols) {
+            for (std::string_view name : chunks[i]->local_symbols->names) {
+                symbols[i].push_back(Symbol::intern(name).get_id());
+            }
+        }
 
-Token* Tokenstream::peek() {
-    // get the next token without consuming it
-    if (pointer < tokens.size()) {
-        return tokens[pointer].get();
+        token_base[i] = count;
+        lexeme_base[i] = lexeme_count;
+        error_base[i] = error_count;
+        count += chunks[i]->tokens.size();
+        lexeme_count += chunks[i]->lexemes.size();
+        error_count += chunks[i]->error_messages.size();
     }
 
-    return nullptr;
-};
+    tokens.resize(count);
+    lexemes.resize(lexeme_count);
+    error_messages.resize(error_count);
+
+    // the chunks are then copied into place in parallel
+    auto copy_chunk = [&](size_t i) {
+        Tokenstream& chunk = *chunks[i];
+        Token* out = tokens.data() + token_base[i];
+
+        for (Token token : chunk.tokens) {
+            switch (token.type) {
+                case TokenType::OBJ_IDENTIFIER:
+                case TokenType::TYPE_IDENTIFIER:
+                    if (chunk.local_symbols) {
+                        token.payload = symbols[i][token.payload];
+                    }
+                    break;
+
+                case TokenType::INTEGER:
+                case TokenType::STRING:
+                    token.payload += lexeme_base[i];
+                    break;
+
+                case TokenType::ERROR:
+                    token.payload += error_base[i];
+                    break;
+
+                default:
+                    break;
+            }
+
+            token.line_number += line_offsets[i];
+            *out++ = token;
+        }
+
+        std::copy(chunk.lexemes.begin(), chunk.lexemes.end(), lexemes.begin() + lexeme_base[i]);
+        std::move(chunk.error_messages.begin(), chunk.error_messages.end(), error_messages.begin() + error_base[i]);
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < chunks.size(); ++i) {
+        workers.emplace_back(copy_chunk, i);
+    }
+    if (!chunks.empty()) {
+        copy_chunk(0);
+    }
+
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    // moving the deques does not move the strings the lexemes point into
+    for (Tokenstream* chunk : chunks) {
+        chunk_strings.push_back(std::move(chunk->materialized_strings));
+    }
+
+    available = count;
+}
 
-// the unget methods move the pointer back
-// useful for backtracking
-void Tokenstream::unget() {
-    pointer--;
+void Tokenstream::intern_local_symbols() {
+    // called for one file after another, so symbol IDs come out in the
+    // order of the files, just as for chunks of a single program
+    local_symbols->ids.reserve(local_symbols->names.size());
+    for (std::string_view name : local_symbols->names) {
+        local_symbols->ids.push_back(Symbol::intern(name).get_id());
+    }
 }
 
-void Tokenstream::unget(uint n) {
-    pointer -= n;
+void Tokenstream::relocate(uint offset) {
+    // identifiers get their interned IDs and lines are moved after the
+    // lines of the previous files; this can run in parallel for each file
+    for (Token& token : tokens) {
+        if (local_symbols && (token.type == TokenType::OBJ_IDENTIFIER || token.type == TokenType::TYPE_IDENTIFIER)) {
+            token.payload = local_symbols->ids[token.payload];
+        }
+        token.line_number += offset;
+    }
+
+    local_symbols.reset();
+    line_offset = offset;
 }
 
-void Tokenstream::consume() {
-    // move the pointer to the next token
-    if (pointer < tokens.size()) {
-        pointer++;
-        return;
+bool Tokenstream::reserve() {
+    // called by the lexer thread before adding a token, waits until the
+    // parser has released the slot that is about to be overwritten
+    if (!bounded || !pipe || !pipe->threaded) {
+        return true;
+    }
+
+    size_t capacity = mask + 1;
+    while (count - pipe->released.load(std::memory_order_acquire) >= capacity) {
+        if (pipe->cancelled.load(std::memory_order_relaxed)) {
+            return false;
+        }
+        pipe->published.store(count, std::memory_order_release);
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+bool Tokenstream::fill() {
+    // make more tokens available to the parser, returns false at the end of input
+    if (!pipe) {
+        return false;
     }
-};
+
+    if (!pipe->threaded) {
+        // lex another batch in this thread, leaving room for the lookbehind
+        size_t target = pointer + (bounded ? (mask + 1) / 2 : SIZE_MAX);
+        bool more = true;
+        while (count < target && (more = pipe->producer())) {}
+
+        available = count;
+        if (!more) {
+            pipe.reset();
+        }
+        return pointer < available;
+    }
+
+    for (;;) {
+        pipe->released.store(pointer > Lookbehind ? pointer - Lookbehind : 0, std::memory_order_release);
+
+        size_t published = pipe->published.load(std::memory_order_acquire);
+        if (published > pointer) {
+            available = published;
+            return true;
+        }
+
+        if (pipe->finished.load(std::memory_order_acquire)) {
+            available = pipe->published.load(std::memory_order_acquire);
+            close();
+            return pointer < available;
+        }
+
+        std::this_thread::yield();
+    }
+}
 
 uint Tokenstream::get_line_number() {
     // get the line number of the token which was last consumed
     if (pointer >= 1) {
-        if (pointer <= tokens.size()) {
-            return tokens[pointer-1].get()->get_line_number();
-        } else {
-            tokens.back()->get_line_number();
-        }
+        return tokens[(pointer-1) & mask].line_number;
     }
-    return 1;
+    return line_offset + 1;
 };
 
-bool Tokenstream::eof() {
-    return pointer >= tokens.size();
+template<typename T, typename Table>
+uint Tokenstream::store(Table& table, size_t& n, T&& value) {
+    // append to a side table or overwrite the oldest slot of a bounded one
+    if (bounded) {
+        table[n & mask] = std::forward<T>(value);
+    } else {
+        table.push_back(std::forward<T>(value));
+    }
+    return n++;
+}
+
+void Tokenstream::add(TokenType type, uint line_number, uint payload) {
+    store(tokens, count, Token{type, line_number, payload});
+
+    if (!pipe || !pipe->threaded) {
+        available = count;
+    } else if ((count & 63) == 0) {
+        // tokens are published to the parser in batches
+        pipe->published.store(count, std::memory_order_release);
+    }
+}
+
+void Tokenstream::add_token(TokenType type, uint line_number) {
+    if (reserve()) {
+        add(type, line_number, 0);
+    }
 }
 
-void Tokenstream::add_token(std::shared_ptr<Token> token) {
-    tokens.push_back(std::move(token));
+void Tokenstream::add_lexeme(TokenType type, std::string_view value, uint line_number) {
+    if (reserve()) {
+        add(type, line_number, store(lexemes, lexeme_count, value));
+    }
+}
+
+void Tokenstream::add_symbol(TokenType type, std::string_view name, uint line_number) {
+    // identifiers are interned once here and only
+    // referred to by their symbol from now on
+    if (reserve()) {
+        add(type, line_number, local_symbols ? local_symbols->intern(name) : Symbol::intern(name).get_id());
+    }
+}
+
+void Tokenstream::add_string(std::string&& value, uint line_number) {
+    // strings with escape sequences own their contents,
+    // the deque keeps them at a stable address
+    if (reserve()) {
+        uint index = store(materialized_strings, string_count, std::move(value));
+        add(TokenType::STRING, line_number, store(lexemes, lexeme_count, std::string_view(materialized_strings[index & mask])));
+    }
+}
+
+void Tokenstream::add_bool(bool value, uint line_number) {
+    if (reserve()) {
+        add(TokenType::BOOL, line_number, value);
+    }
+}
+
+void Tokenstream::add_error(const std::string& msg, uint line_number) {
+    if (reserve()) {
+        add(TokenType::ERROR, line_number, store(error_messages, error_count, msg));
+    }
 }
 
 
@@ -72,103 +290,129 @@ void Tokenstream::add_token(std::shared_ptr<Token> token) {
  *  so that this compiler can be tested using the grading tests from the course.
  */
 
-void Token::dump() {
-    std::string token_name;
+static std::string get_token_name(TokenType type) {
     auto it = token_name_mapping.find(type);
 
     if (it != token_name_mapping.end()) {
-        token_name = it->second;
-    } else {
-        token_name = "UNKNOWN";
+        return it->second;
     }
 
-    std::cout << "#" << line_number << " "
-              << token_name << std::endl;
+    return "UNKNOWN";
 }
 
-void StringToken::dump() {
-    std::cout << "#" << line_number
-              << " STR_CONST ";
-
-    std::cout << get_pretty_string(get_value()) << std::endl;
+void Tokenstream::dump(const Token& token) const {
+    Writer& out = Writer::standard_output();
+    out << '#' << token.line_number << ' ';
+
+    switch (token.type) {
+        case TokenType::STRING:
+            out << "STR_CONST " << get_pretty_string(get_value(&token)) << '\n';
+            break;
+
+        case TokenType::BOOL:
+            out << "BOOL_CONST " << (get_bool(&token) ? "true" : "false") << '\n';
+            break;
+
+        case TokenType::INTEGER:
+            out << "INT_CONST " << get_value(&token) << '\n';
+            break;
+
+        case TokenType::TYPE_IDENTIFIER:
+            out << "TYPEID " << get_symbol(&token) << '\n';
+            break;
+
+        case TokenType::OBJ_IDENTIFIER:
+            out << "OBJECTID " << get_symbol(&token) << '\n';
+            break;
+
+        case TokenType::ERROR:
+            out << "ERROR \"";
+
+            for (char c : get_error(&token)) {
+                if (c == '\\') {
+                    out << "\\\\";
+                } else if (std::isprint(c)) {
+                    out << c;
+                } else {
+                    out << get_numeric_escape(c);
+                }
+            }
+
+            out << '"' << '\n';
+            break;
+
+        default:
+            out << get_token_name(token.type) << '\n';
+            break;
+    }
 }
 
-void BoolToken::dump() {
-    std::string str_value = value ? "true" : "false";
-    std::cout << "#" << line_number
-              << " BOOL_CONST " << str_value
-              << std::endl;
-}
+void Tokenstream::dump_json(const Token& token) const {
+    // one JSON object per line, strings are the raw values rather than escaped for COOL
+    Writer& out = Writer::standard_output();
+    out << "{\"line\":" << token.line_number << ",\"token\":\"";
 
-void IntToken::dump() {
-    std::cout << "#" << line_number
-              << " INT_CONST " << value 
-              << std::endl;
-}
+    switch (token.type) {
+        case TokenType::STRING:
+            out << "STR_CONST\",\"value\":" << get_json_string(get_value(&token));
+            break;
 
-void TypeIdToken::dump() {
-    std::cout << "#" << line_number
-              << " TYPEID " << value
-              << std::endl;
-}
+        case TokenType::BOOL:
+            out << "BOOL_CONST\",\"value\":" << (get_bool(&token) ? "true" : "false");
+            break;
 
-void ObjIdToken::dump() {
-    std::cout << "#" << line_number
-              << " OBJECTID " << value
-              << std::endl;
-}
+        case TokenType::INTEGER:
+            out << "INT_CONST\",\"value\":" << get_json_string(get_value(&token));
+            break;
 
-void ErrorToken::dump() {
-    std::cout << "#" << line_number
-              << " ERROR \"";
-    
-    for (char c : msg) {
-        if (c == '\\') {
-            std::cout << "\\\\";
-        } else if (std::isprint(c)) {
-            std::cout << c;
-        } else {
-            std::cout << "\\" << std::setw(3) << std::setfill('0') << uint(c);
-        }
-    }
+        case TokenType::TYPE_IDENTIFIER:
+            out << "TYPEID\",\"value\":" << get_json_string(get_symbol(&token).str());
+            break;
 
-    std::cout << '"' << std::endl;
-}
+        case TokenType::OBJ_IDENTIFIER:
+            out << "OBJECTID\",\"value\":" << get_json_string(get_symbol(&token).str());
+            break;
 
-void Token::display() {
-    std::string token_name;
-    auto it = token_name_mapping.find(type);
+        case TokenType::ERROR:
+            out << "ERROR\",\"value\":" << get_json_string(get_error(&token));
+            break;
 
-    if (it != token_name_mapping.end()) {
-        token_name = it->second;
-    } else {
-        token_name = "UNKNOWN";
+        default:
+            out << get_token_name(token.type) << '"';
+            break;
     }
 
-    std::cout << token_name << std::endl;
+    out << "}\n";
 }
 
-void StringToken::display() {
-    std::cout << "STR_CONST = " << get_pretty_string(get_value()) << std::endl;
-}
+void Tokenstream::display(std::ostream& out, const Token& token) const {
+    switch (token.type) {
+        case TokenType::STRING:
+            out << "STR_CONST = " << get_pretty_string(get_value(&token)) << std::endl;
+            break;
 
-void BoolToken::display() {
-    std::string str_value = value ? "true" : "false";
-    std::cout << "BOOL_CONST = " << str_value << std::endl;
-}
+        case TokenType::BOOL:
+            out << "BOOL_CONST = " << (get_bool(&token) ? "true" : "false") << std::endl;
+            break;
 
-void IntToken::display() {
-    std::cout << "INT_CONST = " << value << std::endl;
-}
+        case TokenType::INTEGER:
+            out << "INT_CONST = " << get_value(&token) << std::endl;
+            break;
 
-void TypeIdToken::display() {
-    std::cout << "TYPEID = " << value << std::endl;
-}
+        case TokenType::TYPE_IDENTIFIER:
+            out << "TYPEID = " << get_symbol(&token) << std::endl;
+            break;
 
-void ObjIdToken::display() {
-    std::cout << "OBJECTID = " << value << std::endl;
-}
+        case TokenType::OBJ_IDENTIFIER:
+            out << "OBJECTID = " << get_symbol(&token) << std::endl;
+            break;
+
+        case TokenType::ERROR:
+            out << "ERROR = " << get_pretty_string(get_error(&token)) << std::endl;
+            break;
 
-void ErrorToken::display() {
-    std::cout << "ERROR = " << get_pretty_string(get_msg()) << std::endl;
-}
\ No newline at end of file
+        default:
+            out << get_token_name(token.type) << std::endl;
+            break;
+    }
+}
@@ -2,11 +2,22 @@
 #define TOKEN_H
 
 #include <iostream>
+#include <cstdint>
 #include <sstream>
-#include <memory>
+#include <string>
+#include <string_view>
 #include <vector>
+#include <deque>
 #include <map>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <functional>
+#include <algorithm>
+#include <unordered_map>
+#include "symbol.h"
 #include "../utils/pretty_print.h"
+#include "../utils/writer.h"
 
 enum TokenType {
     // keywords go before identifiers, because they 
@@ -105,136 +116,189 @@ const std::map<TokenType, std::string> token_name_mapping = {
         {TokenType::ERROR, "ERROR"}
 };
 
-class Token {
-    protected:
-        TokenType type;
-        uint line_number;
-
-    public:
-        Token(TokenType t, uint ln) {
-            type = t;
-            line_number = ln;
-        }
+// tokens are small POD records stored contiguously in the Tokenstream
+// the payload is interpreted according to the token type:
+//   - identifiers: ID of the interned symbol
+//   - integers and strings: index of the lexeme in the Tokenstream
+//   - booleans: the value of the constant
+//   - errors: index of the error message in the Tokenstream
+//   - other tokens: unused
+struct Token {
+    TokenType type;
+    uint line_number;
+    uint payload;
 
-        virtual ~Token() = default;
+    TokenType get_type() const {
+        return type;
+    }
 
-        TokenType get_type() {
-            return type;
-        }
+    uint get_line_number() const {
+        return line_number;
+    }
+};
 
-        uint get_line_number() {
-            return line_number;
-        }
+// state shared with the lexer when tokens are produced on demand,
+// either in the consumer's thread or by a separate lexer thread
+struct TokenPipe {
+    // runs one step of the lexer, returns false once the input is exhausted
+    std::function<bool()> producer;
+    bool threaded = false;
+    std::thread worker;
 
-        virtual void dump();
-        virtual void display();
+    // absolute token counts, only used when the lexer runs in its own thread:
+    // published is advanced by the lexer, released by the parser
+    std::atomic<size_t> published{0};
+    std::atomic<size_t> released{0};
+    std::atomic<bool> finished{false};
+    std::atomic<bool> cancelled{false};
 };
 
-class StringToken : public Token {
-    private:
-        std::string value;
-    
-    public:
-        StringToken(const std::string& v, uint ln) : Token(TokenType::STRING, ln), value(v) {}
+// when a program is lexed in chunks, identifiers are numbered per chunk and
+// only interned when the chunks are joined, so symbol IDs come out in source order
+struct LocalSymbols {
+    std::vector<std::string_view> names;
+    std::unordered_map<std::string_view, uint> index;
 
-        std::string get_value() {
-            return value;
-        }
+    // interned IDs of the names, for files that are relocated on their own
+    std::vector<uint> ids;
 
-        void dump() override;
-        void display() override;
+    uint intern(std::string_view name) {
+        auto inserted = index.emplace(name, names.size());
+        if (inserted.second) {
+            names.push_back(name);
+        }
+        return inserted.first->second;
+    }
 };
 
-class BoolToken : public Token {
+class Tokenstream {
     private:
-        bool value;
-    
-    public:
-        BoolToken(bool v, uint ln) : Token(TokenType::BOOL, ln), value(v) {}
+        // tokens and their payloads are either kept in full or, in a
+        // bounded stream, in ring buffers indexed by absolute position & mask
+        std::vector<Token> tokens;
+        size_t mask = SIZE_MAX;
+        bool bounded = false;
 
-        bool get_value() {
-            return value;
-        }
+        size_t pointer = 0;     // next token to be read
+        uint line_offset = 0;   // added to the line numbers of a relocated file
+        size_t available = 0;   // number of tokens that can be read
+        size_t count = 0;       // number of tokens added
 
-        void dump() override;
-        void display() override;
-};
+        // side tables for token payloads
+        std::vector<std::string_view> lexemes;
+        std::deque<std::string> materialized_strings;
+        std::vector<std::string> error_messages;
+        size_t lexeme_count = 0;
+        size_t string_count = 0;
+        size_t error_count = 0;
+
+        // strings owned by joined chunks, kept at their original address
+        std::vector<std::deque<std::string>> chunk_strings;
+
+        std::unique_ptr<TokenPipe> pipe;
+        std::unique_ptr<LocalSymbols> local_symbols;
+
+        template<typename T, typename Table>
+        uint store(Table&, size_t&, T&&);
+
+        void add(TokenType, uint, uint);
+        bool reserve();
+        bool fill();
 
-class IntToken : public Token {
-    private:
-        std::string value;
-    
     public:
-        IntToken(const std::string& v, uint ln) : Token(TokenType::INTEGER, ln), value(v) {}
+        // number of consumed tokens a bounded stream keeps around for unget
+        static constexpr size_t Lookbehind = 16;
+        static constexpr size_t DefaultWindow = 4096;
+
+        Tokenstream() = default;
+        explicit Tokenstream(size_t window);
+        Tokenstream(Tokenstream&&) = default;
+        ~Tokenstream();
+
+        // produce tokens lazily instead of up front; the stream must not
+        // be moved once a lexer thread has been started
+        void stream(std::function<bool()> producer, bool threaded);
+        void close();
+
+        // used for the chunks of a program that is lexed in parallel
+        void use_local_symbols();
+        void join(const std::vector<Tokenstream*>& chunks, const std::vector<uint>& line_offsets);
 
-        std::string get_value() {
-            return value;
+        // used for the files of a program that are lexed in parallel
+        void intern_local_symbols();
+        void relocate(uint line_offset);
+
+        const Token* get() {
+            // get the next token and move the pointer
+            if (pointer >= available && !fill()) {
+                return nullptr;
+            }
+            return &tokens[pointer++ & mask];
         }
 
-        void dump() override;
-        void display() override;
-};
+        const Token* peek() {
+            // get the next token without consuming it
+            if (pointer >= available && !fill()) {
+                return nullptr;
+            }
+            return &tokens[pointer & mask];
+        }
 
-class TypeIdToken : public Token {
-    private:
-        std::string value;
-    
-    public:
-        TypeIdToken(const std::string& v, uint ln) : Token(TokenType::TYPE_IDENTIFIER, ln), value(v) {}
+        // the unget methods move the pointer back
+        // useful for backtracking
+        void unget() {
+            pointer--;
+        }
 
-        std::string get_value() {
-            return value;
+        void unget(uint n) {
+            pointer -= n;
         }
 
-        void dump() override;
-        void display() override;
-};
+        void consume() {
+            // move the pointer to the next token
+            if (pointer < available || fill()) {
+                pointer++;
+            }
+        }
 
-class ObjIdToken : public Token {
-    private:
-        std::string value;
-    
-    public:
-        ObjIdToken(const std::string& v, uint ln) : Token(TokenType::OBJ_IDENTIFIER, ln), value(v) {}
+        bool eof() {
+            return pointer >= available && !fill();
+        }
+
+        uint get_line_number();
 
-        std::string get_value() {
-            return value;
+        // number of tokens produced so far
+        size_t size() const {
+            return count;
         }
 
-        void dump() override;
-        void display() override;
-};
+        // payload accessors
+        std::string_view get_value(const Token* token) const {
+            return lexemes[token->payload & mask];
+        }
 
-class ErrorToken : public Token {
-    private:
-        std::string msg;
-    
-    public:
-        ErrorToken(const std::string& m, uint ln) : Token(TokenType::OBJ_IDENTIFIER, ln), msg(m) {}
+        Symbol get_symbol(const Token* token) const {
+            return Symbol(token->payload);
+        }
 
-        std::string get_msg() {
-            return msg;
+        bool get_bool(const Token* token) const {
+            return token->payload != 0;
         }
 
-        void dump() override;
-        void display() override;
-};
+        const std::string& get_error(const Token* token) const {
+            return error_messages[token->payload & mask];
+        }
 
-class Tokenstream {
-    private:
-        std::vector<std::shared_ptr<Token>> tokens;
-        uint pointer = 0;
+        void add_token(TokenType, uint);
+        void add_lexeme(TokenType, std::string_view, uint);
+        void add_symbol(TokenType, std::string_view, uint);
+        void add_string(std::string&&, uint);
+        void add_bool(bool, uint);
+        void add_error(const std::string&, uint);
 
-    public:
-        std::vector<std::shared_ptr<Token>> get_tokens();
-        Token* get();
-        Token* peek();
-        void unget();
-        void unget(uint);
-        void consume();
-        uint get_line_number();
-        void add_token(std::shared_ptr<Token> token);
-        bool eof();
+        void dump(const Token&) const;
+        void dump_json(const Token&) const;
+        void display(std::ostream&, const Token&) const;
 };
 
 #endif
\ No newline at end of file
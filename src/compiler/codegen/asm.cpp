@@ -6,6 +6,12 @@
 
 static const std::string INDENT = "  ";
 
+// every instruction is counted for --stats as it is generated
+static std::string instruction(std::string text) {
+    CompilerStats::instructions.add(text.size());
+    return text;
+}
+
 std::string ptr(const std::string& a) {
     return "[" + a + "]";
 }
@@ -103,163 +109,163 @@ std::string Asm::text_section_start() {
 }
 
 std::string Asm::enter() {
-    return INDENT + "enter 0, 0\n"; 
+    return instruction(INDENT + "enter 0, 0\n"); 
 }
 
 std::string Asm::leave() {
-    return INDENT + "leave\n";  
+    return instruction(INDENT + "leave\n");  
 }
 
 std::string Asm::ret() {
-    return INDENT + "ret\n";
+    return instruction(INDENT + "ret\n");
 }
 
 std::string Asm::ret(uint num) {
-    return INDENT + "ret " + std::to_string(num) + "\n";
+    return instruction(INDENT + "ret " + std::to_string(num) + "\n");
 }
 
 std::string Asm::push(const std::string& a) {
-    return INDENT + "push " + a + "\n";
+    return instruction(INDENT + "push " + a + "\n");
 }
 
 std::string Asm::push(uint a) {
-    return INDENT + "push " + std::to_string(a) + "\n";
+    return instruction(INDENT + "push " + std::to_string(a) + "\n");
 }
 
 std::string Asm::pop(const std::string& a) {
-    return INDENT + "pop " + a + "\n";
+    return instruction(INDENT + "pop " + a + "\n");
 }
 
 std::string Asm::mov(const std::string& a, const std::string& b) {
-    return INDENT + "mov " + a + ", " + b + "\n";
+    return instruction(INDENT + "mov " + a + ", " + b + "\n");
 }
 
 std::string Asm::mov(const std::string& a, uint b) {
-    return INDENT + "mov " + a + ", " + std::to_string(b) + "\n";
+    return instruction(INDENT + "mov " + a + ", " + std::to_string(b) + "\n");
 }
 
 std::string Asm::lea(const std::string& a, const std::string& b) {
-    return INDENT + "lea " + a + ", " + b + "\n";
+    return instruction(INDENT + "lea " + a + ", " + b + "\n");
 }
 
 std::string Asm::xchg(const std::string& a, const std::string& b) {
-    return INDENT + "xchg " + a + ", " + b + "\n";
+    return instruction(INDENT + "xchg " + a + ", " + b + "\n");
 }
 
 std::string Asm::movzx(const std::string& a, const std::string& b) {
-    return INDENT + "movzx " + a + ", " + b + "\n";
+    return instruction(INDENT + "movzx " + a + ", " + b + "\n");
 }
 
 std::string Asm::add(const std::string& a, const std::string& b) {
-    return INDENT + "add " + a + ", " + b + "\n";
+    return instruction(INDENT + "add " + a + ", " + b + "\n");
 }
 
 std::string Asm::add(const std::string& a, uint b) {
-    return INDENT + "add " + a + ", " + std::to_string(b) + "\n";
+    return instruction(INDENT + "add " + a + ", " + std::to_string(b) + "\n");
 }
 
 std::string Asm::sub(const std::string& a, const std::string& b) {
-    return INDENT + "sub " + a + ", " + b + "\n";
+    return instruction(INDENT + "sub " + a + ", " + b + "\n");
 }
 
 std::string Asm::sub(const std::string& a, uint b) {
-    return INDENT + "sub " + a + ", " + std::to_string(b) + "\n";
+    return instruction(INDENT + "sub " + a + ", " + std::to_string(b) + "\n");
 }
 
 std::string Asm::mul(const std::string& a) {
-    return INDENT + "mul " + a + "\n";
+    return instruction(INDENT + "mul " + a + "\n");
 }
 
 std::string Asm::imul(const std::string& a) {
-    return INDENT + "imul " + a + "\n";
+    return instruction(INDENT + "imul " + a + "\n");
 }
 
 std::string Asm::div(const std::string& a) {
-    return INDENT + "div " + a + "\n";
+    return instruction(INDENT + "div " + a + "\n");
 }
 
 std::string Asm::xor_(const std::string& a, const std::string& b) {
-    return INDENT + "xor " + a + ", " + b + "\n";
+    return instruction(INDENT + "xor " + a + ", " + b + "\n");
 }
 
 std::string Asm::xor_(const std::string& a, int b) {
-    return INDENT + "xor " + a + ", " + std::to_string(b) + "\n";
+    return instruction(INDENT + "xor " + a + ", " + std::to_string(b) + "\n");
 }
 
 std::string Asm::neg(const std::string& a) {
-    return INDENT + "neg " + a + "\n";
+    return instruction(INDENT + "neg " + a + "\n");
 }
 
 std::string Asm::inc(const std::string& a) {
-    return INDENT + "inc " + a + "\n";
+    return instruction(INDENT + "inc " + a + "\n");
 }
 
 std::string Asm::dec(const std::string& a) {
-    return INDENT + "dec " + a + "\n";
+    return instruction(INDENT + "dec " + a + "\n");
 }
 
 std::string Asm::cmp(const std::string& a, const std::string& b) {
-    return INDENT + "cmp " + a + ", " + b + "\n";
+    return instruction(INDENT + "cmp " + a + ", " + b + "\n");
 }
 
 std::string Asm::cmp(const std::string& a, uint b) {
-    return INDENT + "cmp " + a + ", " + std::to_string(b) + "\n";
+    return instruction(INDENT + "cmp " + a + ", " + std::to_string(b) + "\n");
 }
 
 std::string Asm::test(const std::string& a, const std::string& b) {
-    return INDENT + "test " + a + ", " + b + "\n";
+    return instruction(INDENT + "test " + a + ", " + b + "\n");
 }
 
 std::string Asm::setz(const std::string& a) {
-    return INDENT + "setz " + a + "\n";
+    return instruction(INDENT + "setz " + a + "\n");
 }
 
 std::string Asm::setg(const std::string& a) {
-    return INDENT + "setg " + a + "\n";
+    return instruction(INDENT + "setg " + a + "\n");
 }
 
 std::string Asm::setge(const std::string& a) {
-    return INDENT + "setge " + a + "\n";
+    return instruction(INDENT + "setge " + a + "\n");
 }
 
 std::string Asm::jmp(const std::string& a) {
-    return INDENT + "jmp " + a + "\n";
+    return instruction(INDENT + "jmp " + a + "\n");
 }
 
 std::string Asm::je(const std::string& a) {
-    return INDENT + "je " + a + "\n";
+    return instruction(INDENT + "je " + a + "\n");
 }
 
 std::string Asm::jne(const std::string& a) {
-    return INDENT + "jne " + a + "\n";
+    return instruction(INDENT + "jne " + a + "\n");
 }
 
 std::string Asm::jg(const std::string& a) {
-    return INDENT + "jg " + a + "\n";
+    return instruction(INDENT + "jg " + a + "\n");
 }
 
 std::string Asm::jl(const std::string& a) {
-    return INDENT + "jl " + a + "\n";
+    return instruction(INDENT + "jl " + a + "\n");
 }
 
 std::string Asm::jns(const std::string& a) {
-    return INDENT + "jns " + a + "\n";
+    return instruction(INDENT + "jns " + a + "\n");
 }
 
 std::string Asm::call(const std::string& a) {
-    return INDENT + "call " + a + "\n";
+    return instruction(INDENT + "call " + a + "\n");
 }
 
 std::string Asm::syscall() {
-    return INDENT + "int 0x80\n";
+    return instruction(INDENT + "int 0x80\n");
 }
 
 std::string Asm::cld() {
-    return INDENT + "cld\n";
+    return instruction(INDENT + "cld\n");
 }
 
 std::string Asm::rep_movsb() {
-    return INDENT + "rep movsb\n";
+    return instruction(INDENT + "rep movsb\n");
 }
 
 std::string Asm::label(const std::string& label) {
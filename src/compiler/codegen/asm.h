@@ -5,6 +5,7 @@
 #include <sstream>
 #include <cmath>
 #include "../../common/consts.h"
+#include "../../common/compiler_stats.h"
 
 static std::string eax = "eax";
 static std::string ebx = "ebx";
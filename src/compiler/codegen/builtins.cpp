@@ -17,7 +17,7 @@ std::string code_uninitialized_basic_objects() {
     std::stringstream ss;
 
     ss << Asm::label(uninitialized_string);
-    ss << Asm::dd(get_class_tag(Strings::Types::String));
+    ss << Asm::dd(get_class_tag(Symbols::Types::String));
     ss << Asm::dd("String_typename");
     ss << Asm::dd((Constants::NumObjHeaders + 2) * Constants::WordSize);
     ss << Asm::dd("String_dispatch_table");
@@ -27,7 +27,7 @@ std::string code_uninitialized_basic_objects() {
     ss << Asm::newline();
 
     ss << Asm::label(uninitialized_int);
-    ss << Asm::dd(get_class_tag(Strings::Types::Int));
+    ss << Asm::dd(get_class_tag(Symbols::Types::Int));
     ss << Asm::dd("Int_typename");
     ss << Asm::dd((Constants::NumObjHeaders + 1) * Constants::WordSize);
     ss << Asm::dd("Int_dispatch_table");
@@ -36,7 +36,7 @@ std::string code_uninitialized_basic_objects() {
     ss << Asm::newline();
 
     ss << Asm::label(uninitialized_bool);
-    ss << Asm::dd(get_class_tag(Strings::Types::Bool));
+    ss << Asm::dd(get_class_tag(Symbols::Types::Bool));
     ss << Asm::dd("Bool_typename");
     ss << Asm::dd((Constants::NumObjHeaders + 1) * Constants::WordSize);
     ss << Asm::dd("Bool_dispatch_table");
@@ -69,7 +69,7 @@ std::string code_input_buffer() {
     return ss.str();
 }
 
-std::string code_builtin_methods() {
+std::string code_builtin_methods(ClassLayout& layout) {
     std::stringstream ss;
 
     ss << Asm::label("Object.abort");
@@ -82,7 +82,7 @@ std::string code_builtin_methods() {
     ss << Asm::mov(eax, ptr(selfptr));
     ss << Asm::push(eax);
     ss << Asm::call("Object.type_name");    // retrieve and print class name
-    ss << Asm::add(eax, get_attr_offset(Strings::Types::String, Strings::Attributes::StrField));
+    ss << Asm::add(eax, layout.get_attribute_offset(Symbols::Types::String, Symbols::Attributes::StrField));
     ss << Asm::mov(eax, ptr(eax));
     ss << Asm::mov(ecx, eax);
     ss << Asm::push(ecx);
@@ -109,7 +109,7 @@ std::string code_builtin_methods() {
     ss << Asm::replace_selfptr("String_proto");
     ss << Asm::call("Object.copy");         // allocate new String object on heap
     ss << Asm::restore_selfptr();
-    ss << Asm::add(eax, get_attr_offset(Strings::Types::String, Strings::Attributes::StrField));
+    ss << Asm::add(eax, layout.get_attribute_offset(Symbols::Types::String, Symbols::Attributes::StrField));
     ss << Asm::pop(ebx);
     ss << Asm::mov(ptr(eax), ebx);          // copy class name to str_field of new String object
     ss << Asm::sub(eax, 4);
@@ -144,7 +144,7 @@ std::string code_builtin_methods() {
     ss << Asm::label("IO.out_string");
     ss << Asm::enter();
     ss << Asm::mov(ecx, ptr(ebp, 8));       // retrieve raw string from String parameter
-    ss << Asm::add(ecx, get_attr_offset(Strings::Types::String, Strings::Attributes::StrField));
+    ss << Asm::add(ecx, layout.get_attribute_offset(Symbols::Types::String, Symbols::Attributes::StrField));
     ss << Asm::mov(ecx, ptr(ecx));          
     ss << Asm::push(ecx);
     ss << Asm::push(ecx);
@@ -235,11 +235,11 @@ std::string code_builtin_methods() {
     ss << Asm::call("Object.copy");
     ss << Asm::restore_selfptr();
     ss << Asm::mov(edx, eax);
-    ss << Asm::add(eax, get_attr_offset(Strings::Types::String, Strings::Attributes::Val));
+    ss << Asm::add(eax, layout.get_attribute_offset(Symbols::Types::String, Symbols::Attributes::Val));
     ss << Asm::pop(ebx);
     ss << Asm::mov(ptr(eax), ebx);
-    ss << Asm::add(eax, get_attr_offset(Strings::Types::String, Strings::Attributes::StrField) 
-                        - get_attr_offset(Strings::Types::String, Strings::Attributes::Val));
+    ss << Asm::add(eax, layout.get_attribute_offset(Symbols::Types::String, Symbols::Attributes::StrField) 
+                        - layout.get_attribute_offset(Symbols::Types::String, Symbols::Attributes::Val));
     ss << Asm::pop(ebx);
     ss << Asm::mov(ptr(eax), ebx);
     ss << Asm::mov(eax, edx);
@@ -250,8 +250,8 @@ std::string code_builtin_methods() {
     ss << Asm::label("IO.in_int");
     ss << Asm::enter();
     ss << Asm::call("IO.in_string");        // get string from stdin using the in_string method
-    ss << Asm::mov(edi, ptr(eax, get_attr_offset(Strings::Types::String, Strings::Attributes::StrField)));
-    ss << Asm::mov(ebx, ptr(eax, get_attr_offset(Strings::Types::String, Strings::Attributes::Val)));
+    ss << Asm::mov(edi, ptr(eax, layout.get_attribute_offset(Symbols::Types::String, Symbols::Attributes::StrField)));
+    ss << Asm::mov(ebx, ptr(eax, layout.get_attribute_offset(Symbols::Types::String, Symbols::Attributes::Val)));
     ss << Asm::add(edi, ebx);
     ss << Asm::dec(edi);
     ss << Asm::xor_(ecx, ecx);
@@ -278,7 +278,7 @@ std::string code_builtin_methods() {
     ss << Asm::call("Object.copy");
     ss << Asm::restore_selfptr();
     ss << Asm::mov(edx, eax);
-    ss << Asm::add(eax, get_attr_offset(Strings::Types::Int, Strings::Attributes::Val));
+    ss << Asm::add(eax, layout.get_attribute_offset(Symbols::Types::Int, Symbols::Attributes::Val));
     ss << Asm::pop(ebx);
     ss << Asm::mov(ptr(eax), ebx);          // copy result to val attribute
     ss << Asm::mov(eax, edx);
@@ -289,14 +289,14 @@ std::string code_builtin_methods() {
     ss << Asm::label("String.length");
     ss << Asm::enter();                     // access the val attribute
     ss << Asm::mov(eax, ptr(selfptr));      // containing the string length
-    ss << Asm::add(eax, get_attr_offset(Strings::Types::String, Strings::Attributes::Val));
+    ss << Asm::add(eax, layout.get_attribute_offset(Symbols::Types::String, Symbols::Attributes::Val));
     ss << Asm::mov(eax, ptr(eax));
     ss << Asm::push(eax);
     ss << Asm::replace_selfptr("Int_proto"); 
     ss << Asm::call("Object.copy");
     ss << Asm::restore_selfptr();
     ss << Asm::mov(edx, eax);
-    ss << Asm::add(eax, get_attr_offset(Strings::Types::Int, Strings::Attributes::Val));
+    ss << Asm::add(eax, layout.get_attribute_offset(Symbols::Types::Int, Symbols::Attributes::Val));
     ss << Asm::pop(ebx);
     ss << Asm::mov(ptr(eax), ebx);          // allocate new Int and
     ss << Asm::mov(eax, edx);               // copy length to val attribute
@@ -307,7 +307,7 @@ std::string code_builtin_methods() {
     ss << Asm::label("String.concat");
     ss << Asm::enter();
     ss << Asm::call("String.length");       // get length of first string
-    ss << Asm::add(eax, get_attr_offset(Strings::Types::Int, Strings::Attributes::Val));
+    ss << Asm::add(eax, layout.get_attribute_offset(Symbols::Types::Int, Symbols::Attributes::Val));
     ss << Asm::mov(eax, ptr(eax));
     ss << Asm::push(eax);
     ss << Asm::mov(edi, ptr(ebp, 8));
@@ -315,7 +315,7 @@ std::string code_builtin_methods() {
     ss << Asm::push(ecx);
     ss << Asm::mov(dword_ptr(selfptr), edi);
     ss << Asm::call("String.length");       // get length of second string
-    ss << Asm::add(eax, get_attr_offset(Strings::Types::Int, Strings::Attributes::Val));
+    ss << Asm::add(eax, layout.get_attribute_offset(Symbols::Types::Int, Symbols::Attributes::Val));
     ss << Asm::mov(eax, ptr(eax));
     ss << Asm::pop(ecx);
     ss << Asm::mov(dword_ptr(selfptr), ecx);
@@ -329,13 +329,13 @@ std::string code_builtin_methods() {
     ss << Asm::call("_allocate_memory");    
     ss << Asm::mov(edi, eax);
     ss << Asm::mov(esi, ptr(selfptr));
-    ss << Asm::add(esi, get_attr_offset(Strings::Types::String, Strings::Attributes::StrField));
+    ss << Asm::add(esi, layout.get_attribute_offset(Symbols::Types::String, Symbols::Attributes::StrField));
     ss << Asm::mov(esi, ptr(esi));
     ss << Asm::mov(ecx, ptr(ebp, -4));
     ss << Asm::cld();                       // copy first string to new location
     ss << Asm::rep_movsb();
     ss << Asm::mov(esi, ptr(ebp, 8));
-    ss << Asm::add(esi, get_attr_offset(Strings::Types::String, Strings::Attributes::StrField));
+    ss << Asm::add(esi, layout.get_attribute_offset(Symbols::Types::String, Symbols::Attributes::StrField));
     ss << Asm::mov(esi, ptr(esi));
     ss << Asm::mov(ecx, ptr(ebp, -8));
     ss << Asm::inc(ecx);
@@ -346,7 +346,7 @@ std::string code_builtin_methods() {
     ss << Asm::call("Object.copy");
     ss << Asm::restore_selfptr();
     ss << Asm::mov(ebx, eax);               // make and return new String object
-    ss << Asm::add(eax, get_attr_offset(Strings::Types::String, Strings::Attributes::StrField));
+    ss << Asm::add(eax, layout.get_attribute_offset(Symbols::Types::String, Symbols::Attributes::StrField));
     ss << Asm::pop(ecx);
     ss << Asm::mov(ptr(eax), ecx);
     ss << Asm::sub(eax, 4);
@@ -360,36 +360,36 @@ std::string code_builtin_methods() {
     ss << Asm::label("String.substr");
     ss << Asm::enter();
     ss << Asm::mov(eax, ptr(ebp, 12));      // get start index
-    ss << Asm::add(eax, get_attr_offset(Strings::Types::Int, Strings::Attributes::Val));
+    ss << Asm::add(eax, layout.get_attribute_offset(Symbols::Types::Int, Symbols::Attributes::Val));
     ss << Asm::mov(eax, ptr(eax));
     ss << Asm::cmp(eax, 0);                 // verify that it is in bounds (>= 0)
     ss << Asm::jl(".error");
     ss << Asm::mov(ebx, ptr(ebp, 8));       // get end index and
-    ss << Asm::add(ebx, get_attr_offset(Strings::Types::Int, Strings::Attributes::Val));
+    ss << Asm::add(ebx, layout.get_attribute_offset(Symbols::Types::Int, Symbols::Attributes::Val));
     ss << Asm::mov(ebx, ptr(ebx));          
     ss << Asm::add(ebx, eax);
     ss << Asm::push(ebx);                   
     ss << Asm::call("String.length");       // get length of string
-    ss << Asm::add(eax, get_attr_offset(Strings::Types::Int, Strings::Attributes::Val));
+    ss << Asm::add(eax, layout.get_attribute_offset(Symbols::Types::Int, Symbols::Attributes::Val));
     ss << Asm::mov(eax, ptr(eax));
     ss << Asm::pop(ebx);
     ss << Asm::cmp(ebx, eax);
     ss << Asm::jg(".error");                // verify that end index is in bounds
     ss << Asm::mov(eax, ptr(ebp, 8));
-    ss << Asm::add(eax, get_attr_offset(Strings::Types::Int, Strings::Attributes::Val));
+    ss << Asm::add(eax, layout.get_attribute_offset(Symbols::Types::Int, Symbols::Attributes::Val));
     ss << Asm::mov(eax, ptr(eax));
     ss << Asm::inc(eax);
     ss << Asm::push(eax);
     ss << Asm::call("_allocate_memory");    // allocate memory for new string
     ss << Asm::mov(edi, eax);
     ss << Asm::mov(ecx, ptr(ebp, 8));
-    ss << Asm::add(ecx, get_attr_offset(Strings::Types::Int, Strings::Attributes::Val));
+    ss << Asm::add(ecx, layout.get_attribute_offset(Symbols::Types::Int, Symbols::Attributes::Val));
     ss << Asm::mov(ecx, ptr(ecx));
     ss << Asm::mov(esi, ptr(selfptr));
-    ss << Asm::add(esi, get_attr_offset(Strings::Types::String, Strings::Attributes::StrField));
+    ss << Asm::add(esi, layout.get_attribute_offset(Symbols::Types::String, Symbols::Attributes::StrField));
     ss << Asm::mov(esi, ptr(esi));
     ss << Asm::mov(eax, ptr(ebp, 12));
-    ss << Asm::add(eax, get_attr_offset(Strings::Types::Int, Strings::Attributes::Val));
+    ss << Asm::add(eax, layout.get_attribute_offset(Symbols::Types::Int, Symbols::Attributes::Val));
     ss << Asm::mov(eax, ptr(eax));
     ss << Asm::add(esi, eax);
     ss << Asm::push(edi);
@@ -410,7 +410,7 @@ std::string code_builtin_methods() {
     ss << Asm::restore_selfptr();
     ss << Asm::mov(edx, eax);               // make and return new String object
     ss << Asm::pop(ebx);
-    ss << Asm::add(eax, get_attr_offset(Strings::Types::String, Strings::Attributes::Val));
+    ss << Asm::add(eax, layout.get_attribute_offset(Symbols::Types::String, Symbols::Attributes::Val));
     ss << Asm::mov(ptr(eax), ebx);
     ss << Asm::pop(ebx);
     ss << Asm::add(eax, 4);
@@ -521,7 +521,7 @@ std::string code_entrypoint() {
     return ss.str();
 }
 
-std::string code_internal_routines() {
+std::string code_internal_routines(ClassLayout& layout) {
     // various routines used internally
     std::stringstream ss;
 
@@ -561,7 +561,7 @@ std::string code_internal_routines() {
     ss << Asm::call("Object.copy");
     ss << Asm::restore_selfptr();
     ss << Asm::mov(edx, eax);
-    ss << Asm::add(eax, get_attr_offset(Strings::Types::Bool, Strings::Attributes::Val));
+    ss << Asm::add(eax, layout.get_attribute_offset(Symbols::Types::Bool, Symbols::Attributes::Val));
     ss << Asm::mov(dword_ptr(eax), 1);
     ss << Asm::mov(eax, edx);
     ss << Asm::jmp(".done");
@@ -570,7 +570,7 @@ std::string code_internal_routines() {
     ss << Asm::call("Object.copy");
     ss << Asm::restore_selfptr();
     ss << Asm::mov(edx, eax);
-    ss << Asm::add(eax, get_attr_offset(Strings::Types::Bool, Strings::Attributes::Val));
+    ss << Asm::add(eax, layout.get_attribute_offset(Symbols::Types::Bool, Symbols::Attributes::Val));
     ss << Asm::mov(dword_ptr(eax), 0);
     ss << Asm::mov(eax, edx);
     ss << Asm::label(".done");
@@ -6,9 +6,9 @@
 
 // start naming classes from 100
 static uint class_tag_num = 100;
-static std::map<std::string, uint> class_tag_map;
+static std::unordered_map<Symbol, uint> class_tag_map;
 
-uint get_class_tag(const std::string& cls) {
+uint get_class_tag(Symbol cls) {
     if (class_tag_map.find(cls) == class_tag_map.end()) {
         // new class tag
         class_tag_map[cls] = class_tag_num++;
@@ -17,7 +17,7 @@ uint get_class_tag(const std::string& cls) {
     return class_tag_map[cls];
 }
 
-std::string get_class_by_tag(uint tag) {
+Symbol get_class_by_tag(uint tag) {
     for (const auto& pair : class_tag_map) {
         if (pair.second == tag) {
             return pair.first;
@@ -1,11 +1,11 @@
 #ifndef CLASSTAG_H
 #define CLASSTAG_H
 
-#include <map>
-#include <string>
+#include <unordered_map>
 #include <stdexcept>
+#include "../../common/symbol.h"
 
-uint get_class_tag(const std::string&);
-std::string get_class_by_tag(uint);
+uint get_class_tag(Symbol);
+Symbol get_class_by_tag(uint);
 
 #endif
\ No newline at end of file
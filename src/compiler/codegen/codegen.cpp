@@ -10,12 +10,13 @@
 static std::ofstream outfile;
 static ProgramNode* ast;
 static ClassTable* classtable;
+static ClassLayout* layout;
 static ScopeStack scope_stack;
 
 static uint string_counter = 0;
 static std::map<std::string, std::string> strings;
 
-static std::string current_class = "";
+static Symbol current_class;
 
 template<typename T>
 std::string unique_label(const std::string& name, const T& ptr) {
@@ -33,7 +34,7 @@ void make_new_int_object(const T& value) {
     outfile << Asm::call("Object.copy");
     outfile << Asm::restore_selfptr();
     outfile << Asm::pop(ebx);
-    outfile << Asm::mov(dword_ptr(eax, get_attr_offset(Strings::Types::Int, Strings::Attributes::Val)), ebx);
+    outfile << Asm::mov(dword_ptr(eax, layout->get_attribute_offset(Symbols::Types::Int, Symbols::Attributes::Val)), ebx);
 }
 
 template<typename T>
@@ -44,18 +45,7 @@ void make_new_bool_object(const T& value) {
     outfile << Asm::call("Object.copy");
     outfile << Asm::restore_selfptr();
     outfile << Asm::pop(ebx);
-    outfile << Asm::mov(ptr(eax, get_attr_offset(Strings::Types::Bool, Strings::Attributes::Val)), ebx);
-}
-
-uint calculate_obj_size(ClassNode* cls) {
-    uint size = Constants::NumObjHeaders;
-
-    for (const std::string& clsname : classtable->get_ancestry(cls->get_name())) {
-        ClassNode* inherited_class = classtable->clsmap[clsname];
-        size += inherited_class->get_attributes().size();
-    }
-
-    return size * Constants::WordSize;
+    outfile << Asm::mov(ptr(eax, layout->get_attribute_offset(Symbols::Types::Bool, Symbols::Attributes::Val)), ebx);
 }
 
 void build_class_prototypes() {
@@ -63,63 +53,48 @@ void build_class_prototypes() {
     outfile << Asm::dd(0);
     outfile << Asm::newline();
 
-    for (auto it = classtable->clsmap.begin(); it != classtable->clsmap.end(); ++it) {
-        std::string clsname = it->first;
-        ClassNode* cls = it->second;
+    for (ClassNode* cls : classtable->get_classes()) {
+        Symbol clsname = cls->get_name();
 
-        outfile << Asm::comment("class " + clsname);
-        outfile << Asm::label(clsname + "_proto");
+        outfile << Asm::comment("class " + clsname.str());
+        outfile << Asm::label(clsname.str() + "_proto");
 
         // unique class tag
         outfile << Asm::dd(get_class_tag(clsname));
 
         // typename 
-        outfile << Asm::dd(clsname + "_typename");
-        strings[cls->get_name() + "_typename"] = cls->get_name();
+        outfile << Asm::dd(clsname.str() + "_typename");
+        strings[clsname.str() + "_typename"] = clsname.str();
 
         // object size = (number of attributes + number of headers) * word size
-        outfile << Asm::dd(calculate_obj_size(cls));
+        outfile << Asm::dd(layout->get_object_size(clsname));
 
         // dispatch pointer  
-        outfile << Asm::dd(clsname + "_dispatch_table");
+        outfile << Asm::dd(clsname.str() + "_dispatch_table");
 
         // parent class
-        if (clsname == Strings::Types::Object) {
+        if (clsname == Symbols::Types::Object) {
             outfile << Asm::dd(0);  // Object has no parent
         } else {
-            outfile << Asm::dd(cls->get_base_class() + "_proto");
+            outfile << Asm::dd(cls->get_base_class().str() + "_proto");
         }
 
-        uint count = Constants::NumObjHeaders; // account for the headers in the offset calculations
-        std::vector<std::string> ancestry = classtable->get_ancestry(clsname);
-        
-        for (auto it = ancestry.rbegin(); it != ancestry.rend(); ++it) {
-            std::string clsname = *it;
-            ClassNode* inherited_class = classtable->clsmap[clsname];
-
-            if (clsname == Strings::Types::String) {
-                // handle String object as a special case:
-                // use simple int (not Int object) as val and
-                // empty_string as str_field
-                set_attr_offset(clsname, Strings::Attributes::Val, 4 * count++);
-                outfile << Asm::comment("attribute val");
-                outfile << Asm::dd(0);
-                set_attr_offset(clsname, Strings::Attributes::StrField, 4 * count++);
-                outfile << Asm::comment("attribute str_field");
-                outfile << Asm::dd(empty_string);
-                continue;
-            }
-
-            for (AttributeNode* attr : inherited_class->get_attributes()) {
-                // inherited attributes cannot be redefined -
-                // no need to check for overriding
-                set_attr_offset(clsname, attr->get_name(), 4 * count++);
-                outfile << Asm::comment("attribute " + attr->get_name());
-                if (attr->get_type() == Strings::Types::String) {
+        if (clsname == Symbols::Types::String) {
+            // handle String object as a special case:
+            // use simple int (not Int object) as val and
+            // empty_string as str_field
+            outfile << Asm::comment("attribute val");
+            outfile << Asm::dd(0);
+            outfile << Asm::comment("attribute str_field");
+            outfile << Asm::dd(empty_string);
+        } else {
+            for (AttributeNode* attr : layout->get_attributes(clsname)) {
+                outfile << Asm::comment("attribute " + attr->get_name().str());
+                if (attr->get_type() == Symbols::Types::String) {
                     outfile << Asm::dd(uninitialized_string);
-                } else if (attr->get_type() == Strings::Types::Int) {
+                } else if (attr->get_type() == Symbols::Types::Int) {
                     outfile << Asm::dd(uninitialized_int);
-                } else if (attr->get_type() == Strings::Types::Bool) {
+                } else if (attr->get_type() == Symbols::Types::Bool) {
                     outfile << Asm::dd(uninitialized_bool);
                 } else {
                     // other classes are just void
@@ -137,42 +112,21 @@ void build_class_prototypes() {
 void print_dispatch_tables() {
     outfile << Asm::comment("dispatch tables");
 
-    for (auto it = classtable->clsmap.begin(); it != classtable->clsmap.end(); ++it) {
-        std::string clsname = it->first;
-        outfile << Asm::label(clsname + "_dispatch_table");
-
-        std::vector<std::pair<std::string, std::string>> methods;
-        std::vector<std::string> ancestry = classtable->get_ancestry(clsname);
-        
-        for (auto it = ancestry.rbegin(); it != ancestry.rend(); ++it) {
-            std::string clsname = *it;
-            ClassNode* inherited_class = classtable->clsmap[clsname];
-            for (MethodNode* method : inherited_class->get_methods()) {
-                // check for overriding
-                bool overridden = false;
-                for (size_t i = 0; i < methods.size(); ++i) {
-                    if (method->get_name() == methods[i].second) {
-                        methods[i] = std::make_pair(clsname, method->get_name());
-                        overridden = true;
-                        break;
-                    }
-                }
-                
-                if (!overridden) {
-                    methods.push_back(std::make_pair(clsname, method->get_name()));
-                }
-            }
-        }
+    for (ClassNode* cls : classtable->get_classes()) {
+        Symbol clsname = cls->get_name();
+        outfile << Asm::label(clsname.str() + "_dispatch_table");
 
         // add the internal _init function to the dispatch table
-        outfile << Asm::dd(clsname + "._init");
+        outfile << Asm::dd(clsname.str() + "._init");
 
-        uint count = 1;
-        for (std::pair<std::string, std::string> method : methods) {
-            outfile << Asm::dd(method.first + "." + method.second);
-            set_method_offset(clsname, method.second, 4 * count++);
+        Span<ClassLayout::Slot> dispatch_table = layout->get_dispatch_table(clsname);
+        for (ClassLayout::Slot slot : dispatch_table) {
+            outfile << Asm::dd(slot.cls.str() + "." + slot.method.str());
         }
 
+        // a class takes up its prototype and its dispatch table
+        CompilerStats::classes.add(layout->get_object_size(clsname) + Constants::WordSize * (dispatch_table.size() + 1));
+
         outfile << std::endl;
     }
 }
@@ -184,6 +138,7 @@ void print_string_constants() {
         std::string label = string.first;
         std::string value = string.second;
         outfile << Asm::static_string(label, value);
+        CompilerStats::string_constants.add(value.size());
     }
 
     outfile << code_builtin_static_strings();
@@ -202,11 +157,11 @@ void code_initializers() {
     outfile << Asm::comment("internal initializer methods");
     
     for (ClassNode* cls : ast->get_classes()) {
-        std::string type = cls->get_name();
-        outfile << Asm::label(type + "._init");
+        Symbol type = cls->get_name();
+        outfile << Asm::label(type.str() + "._init");
         
         // get prototype
-        outfile << Asm::mov(eax, type + "_proto");
+        outfile << Asm::mov(eax, type.str() + "_proto");
 
         // get size and allocate memory
         outfile << Asm::mov(ebx, ptr(eax, 8));
@@ -223,42 +178,35 @@ void code_initializers() {
 
         // evaluate initializers
         // switch to new class so we use its dispatch table as offset
-        std::string old_class = current_class;
+        Symbol old_class = current_class;
         current_class = cls->get_name();
         outfile << Asm::replace_selfptr(eax);
         outfile << Asm::push(eax);
 
         // add all the attributes to the scope
-        // (attributes may use other attributes in their initialization)        
-        std::vector<std::string> ancestry = classtable->get_ancestry(cls->get_name());
-        uint offset = Constants::NumObjHeaders;
-
-        for (auto it = ancestry.rbegin(); it != ancestry.rend(); ++it) {
-            std::string clsname = *it;
-            ClassNode* cls = classtable->clsmap[clsname];
-            for (AttributeNode* attr : cls->get_attributes()) {
-                scope_stack.add_attribute(attr->get_name(), Constants::WordSize * offset++);
-            }
+        // (attributes may use other attributes in their initialization)
+        Span<AttributeNode*> attributes = layout->get_attributes(type);
+        scope_stack.enter_scope();
+        for (size_t i = 0; i < attributes.size(); ++i) {
+            scope_stack.add_attribute(attributes[i]->get_name(), ClassLayout::get_attribute_offset(i));
         }
 
         // initialize the attributes
-        for (auto it = ancestry.rbegin(); it != ancestry.rend(); ++it) {
-            std::string clsname = *it;
-            ClassNode* cls = classtable->clsmap[clsname];
-            for (AttributeNode* attr : cls->get_attributes()) {
-                outfile << Asm::comment("evaluate initializer " + attr->get_name());
-                
-                // make a clean temporary stack frame free from the init stuff on the stack
-                // for evaluating attributes initializers
-                outfile << Asm::enter();
-                attr->get_expr()->code();
-                outfile << Asm::leave();
-
-                outfile << Asm::pop(edi);
-                outfile << Asm::mov(ptr(edi, get_attr_offset(cls->get_name(), attr->get_name())), eax);
-                outfile << Asm::push(edi);
-            }
+        for (size_t i = 0; i < attributes.size(); ++i) {
+            AttributeNode* attr = attributes[i];
+            outfile << Asm::comment("evaluate initializer " + attr->get_name().str());
+
+            // make a clean temporary stack frame free from the init stuff on the stack
+            // for evaluating attributes initializers
+            outfile << Asm::enter();
+            attr->get_expr()->code();
+            outfile << Asm::leave();
+
+            outfile << Asm::pop(edi);
+            outfile << Asm::mov(ptr(edi, ClassLayout::get_attribute_offset(i)), eax);
+            outfile << Asm::push(edi);
         }
+        scope_stack.exit_scope();
 
         // return address of new object
         current_class = old_class;
@@ -269,20 +217,20 @@ void code_initializers() {
     }
 
     // the built-in classes are special (with prim_slot and all)
-    for (const std::string& cls : { Strings::Types::Object, 
-                             Strings::Types::Int, 
-                             Strings::Types::Bool, 
-                             Strings::Types::String, 
-                             Strings::Types::IO 
-                           }) {
-        uint attr_num = classtable->clsmap[cls]->get_attributes().size();
-
-        outfile << Asm::label(cls + "._init");
+    for (Symbol cls : { Symbols::Types::Object, 
+                        Symbols::Types::Int, 
+                        Symbols::Types::Bool, 
+                        Symbols::Types::String, 
+                        Symbols::Types::IO 
+                      }) {
+        uint attr_num = classtable->find(cls)->get_attributes().size();
+
+        outfile << Asm::label(cls.str() + "._init");
         outfile << Asm::push((Constants::NumObjHeaders + attr_num) * Constants::WordSize);
         outfile << Asm::call("_allocate_memory");
         outfile << Asm::push(eax);
         outfile << Asm::mov(edi, eax);
-        outfile << Asm::mov(esi, cls + "_proto");
+        outfile << Asm::mov(esi, cls.str() + "_proto");
         outfile << Asm::mov(ecx, (Constants::NumObjHeaders + attr_num) * Constants::WordSize);
         outfile << Asm::cld();
         outfile << Asm::rep_movsb();
@@ -298,7 +246,7 @@ void build_text_segment() {
 
     // built-in methods
     outfile << Asm::comment("built-in methods");
-    outfile << code_builtin_methods();
+    outfile << code_builtin_methods(*layout);
 
     // initializers for each class
     code_initializers();
@@ -310,26 +258,21 @@ void build_text_segment() {
             // setup scope for each method
             current_class = cls->get_name();
             scope_stack.enter_scope();
-            Scope* scope = scope_stack.get_scope();
-
-            std::vector<std::string> ancestry = classtable->get_ancestry(cls->get_name());
-            for (auto it = ancestry.rbegin(); it != ancestry.rend(); ++it) {
-                std::string clsname = *it;
-                ClassNode* cls = classtable->clsmap[clsname];
-                for (AttributeNode* attr : cls->get_attributes()) {
-                    uint offset = get_attr_offset(cls->get_name(), attr->get_name());
-                    scope_stack.add_attribute(attr->get_name(), offset);
-                }
+
+            Span<AttributeNode*> attributes = layout->get_attributes(cls->get_name());
+            for (size_t i = 0; i < attributes.size(); ++i) {
+                scope_stack.add_attribute(attributes[i]->get_name(), ClassLayout::get_attribute_offset(i));
             }
 
-            std::vector<FormalNode*> formals = method->get_formals()->get_formals();
+            NodeList<FormalNode*> formals = method->get_formals()->get_formals();
             for (auto it = formals.rbegin(); it != formals.rend(); ++it) {
                 FormalNode* formal = *it;
-                scope->add_parameter(formal->get_name());
+                scope_stack.add_parameter(formal->get_name());
             }
 
             // generate code for method
-            outfile << Asm::label(cls->get_name() + "." + method->get_name());
+            std::streampos method_start = outfile.tellp();
+            outfile << Asm::label(cls->get_name().str() + "." + method->get_name().str());
             outfile << Asm::enter();
             method->get_expr()->code();
             outfile << Asm::leave();
@@ -337,13 +280,14 @@ void build_text_segment() {
             // clean up dispatch parameters
             outfile << Asm::ret(method->get_formals()->get_formals().size() * Constants::WordSize);
             outfile << Asm::newline();
+            CompilerStats::methods.add(outfile.tellp() - method_start);
 
             scope_stack.exit_scope();
         }
     }
 
     // internals
-    outfile << code_internal_routines();
+    outfile << code_internal_routines(*layout);
 
     // init Main and set selfptr to the new Main instance
     // call Main.main and execute cleanly afterwards
@@ -359,34 +303,57 @@ void generate_code(ProgramNode& program, std::string filename, ClassTable* c) {
     ast = &program;
     classtable = c;
 
+    // lay out the objects and dispatch tables of all classes once
+    std::unique_ptr<ClassLayout> class_layout;
+    {
+        PhaseTimer timer(Phase::Layout);
+        class_layout = std::make_unique<ClassLayout>(*classtable);
+        layout = class_layout.get();
+    }
+
     scope_stack.enter_scope();
 
     // build first data segment
     // objects and dispatch tables
-    outfile << Asm::data_section_start();
-    build_class_prototypes(); 
-    print_dispatch_tables();
+    {
+        PhaseTimer timer(Phase::Prototypes);
+        outfile << Asm::data_section_start();
+        build_class_prototypes(); 
+        print_dispatch_tables();
+    }
 
     // build text segment
-    outfile << Asm::text_section_start();
-    build_text_segment();
+    {
+        PhaseTimer timer(Phase::Methods);
+        outfile << Asm::text_section_start();
+        build_text_segment();
+    }
 
     // build second data segment
     // static strings, heap and I/O buffer
-    outfile << Asm::data_section_start();
-    print_string_constants();
-    print_heap();
-    print_input_buffer();
+    {
+        PhaseTimer timer(Phase::Output);
+        outfile << Asm::data_section_start();
+        print_string_constants();
+        print_heap();
+        print_input_buffer();
+        outfile.close();
+    }
 }
 
-void NoExpressionNode::code() {
-    std::string type = get_declared_type();
+// every nested expression is generated through here
+void ExpressionNode::code() {
+    StackSegments::nested([&] { emit_code(); });
+}
+
+void NoExpressionNode::emit_code() {
+    Symbol type = get_declared_type();
 
-    if (type == Strings::Types::String 
-        || type == Strings::Types::Int 
-        || type == Strings::Types::Bool
+    if (type == Symbols::Types::String 
+        || type == Symbols::Types::Int 
+        || type == Symbols::Types::Bool
     ) {
-        outfile << Asm::replace_selfptr(type + "_proto");
+        outfile << Asm::replace_selfptr(type.str() + "_proto");
         outfile << Asm::call("Object.copy");
         outfile << Asm::restore_selfptr();
     } else {
@@ -395,11 +362,17 @@ void NoExpressionNode::code() {
     }
 }
 
-void IntNode::code() {
-    make_new_int_object(get_value());
+void IntNode::emit_code() {
+    // the digits are accumulated modulo 2^32, as the target would truncate them
+    uint32_t value = 0;
+    for (char digit : get_value()) {
+        value = value * 10 + (digit - '0');
+    }
+
+    make_new_int_object(value);
 }
 
-void StringNode::code() {
+void StringNode::emit_code() {
     // register the string value so it added to the .data section
     std::string string_label = "string_" + std::to_string(string_counter++);
     strings[string_label] = get_escaped_string(get_value());
@@ -408,7 +381,7 @@ void StringNode::code() {
     outfile << Asm::call("Object.copy");
     outfile << Asm::restore_selfptr();
     outfile << Asm::mov(ebx, eax);
-    outfile << Asm::add(eax, get_attr_offset(Strings::Types::String, Strings::Attributes::StrField));
+    outfile << Asm::add(eax, layout->get_attribute_offset(Symbols::Types::String, Symbols::Attributes::StrField));
     outfile << Asm::mov(dword_ptr(eax), string_label);
     outfile << Asm::sub(eax, 4);
     outfile << Asm::push(eax);
@@ -419,17 +392,17 @@ void StringNode::code() {
     outfile << Asm::lea(eax, ptr(ebx, -Constants::NumObjHeaders * Constants::WordSize));
 }
 
-void BoolNode::code() {
+void BoolNode::emit_code() {
     make_new_bool_object(get_value());
 }
 
-void IdentifierNode::code() {
+void IdentifierNode::emit_code() {
     // retrieve object from scope
     outfile << scope_stack.get_location(get_name()) << std::endl;
     outfile << Asm::mov(eax, ptr(eax));
 }
 
-void AssignmentNode::code() {
+void AssignmentNode::emit_code() {
     // evaluate expression and store it in the object
     get_expr()->code();
     outfile << Asm::push(eax);
@@ -439,11 +412,11 @@ void AssignmentNode::code() {
     outfile << Asm::pop(eax);
 }
 
-void NewNode::code() {
+void NewNode::emit_code() {
     // call the _init method of the class
-    std::string type = get_type();
+    Symbol type = get_type();
     
-    if (type == Strings::Types::SelfType) {
+    if (type == Symbols::Types::SelfType) {
         // if type is 'SELF_TYPE', we have to get 
         // the type of the current 'self' object
         outfile << Asm::mov(eax, ptr(selfptr));
@@ -451,11 +424,11 @@ void NewNode::code() {
         outfile << Asm::mov(eax, ptr(eax));
         outfile << Asm::call(eax);
     } else {
-        outfile << Asm::call(type + "._init");
+        outfile << Asm::call(type.str() + "._init");
     }
 }
 
-void IsvoidNode::code() {
+void IsvoidNode::emit_code() {
     // return a boolean indicating 
     // whether the object is a null pointer
     get_expr()->code();
@@ -465,19 +438,19 @@ void IsvoidNode::code() {
     make_new_bool_object(eax);
 }
 
-void NegNode::code() {
+void NegNode::emit_code() {
     // retrieve the integer value and negate it
     get_expr()->code();
-    outfile << Asm::add(eax, get_attr_offset(Strings::Types::Int, Strings::Attributes::Val));
+    outfile << Asm::add(eax, layout->get_attribute_offset(Symbols::Types::Int, Symbols::Attributes::Val));
     outfile << Asm::mov(eax, ptr(eax));
     outfile << Asm::neg(eax);
     make_new_int_object(eax);
 }
 
-void ComplementNode::code() {
+void ComplementNode::emit_code() {
     // retrieve the boolean (1 or 0) value and xor with 1
     get_expr()->code();
-    outfile << Asm::add(eax, get_attr_offset(Strings::Types::Int, Strings::Attributes::Val));
+    outfile << Asm::add(eax, layout->get_attribute_offset(Symbols::Types::Int, Symbols::Attributes::Val));
     outfile << Asm::mov(eax, ptr(eax));
     outfile << Asm::xor_(eax, 1);
     make_new_bool_object(eax);
@@ -487,46 +460,46 @@ void ComplementNode::code() {
 // push it onto the stack, evaluate the right, pop the left from 
 // the stack, and then perform the operation
 
-void PlusNode::code() {
+void PlusNode::emit_code() {
     get_first()->code();
-    outfile << Asm::mov(eax, ptr(eax, get_attr_offset(Strings::Types::Int, Strings::Attributes::Val)));
+    outfile << Asm::mov(eax, ptr(eax, layout->get_attribute_offset(Symbols::Types::Int, Symbols::Attributes::Val)));
     outfile << Asm::push(eax);
     get_second()->code();
-    outfile << Asm::mov(eax, ptr(eax, get_attr_offset(Strings::Types::Int, Strings::Attributes::Val)));
+    outfile << Asm::mov(eax, ptr(eax, layout->get_attribute_offset(Symbols::Types::Int, Symbols::Attributes::Val)));
     outfile << Asm::pop(ebx);
     outfile << Asm::add(eax, ebx);
     make_new_int_object(eax);
 }
 
-void MinusNode::code() {
+void MinusNode::emit_code() {
     get_first()->code();
-    outfile << Asm::mov(eax, ptr(eax, get_attr_offset(Strings::Types::Int, Strings::Attributes::Val)));
+    outfile << Asm::mov(eax, ptr(eax, layout->get_attribute_offset(Symbols::Types::Int, Symbols::Attributes::Val)));
     outfile << Asm::push(eax);
     get_second()->code();
-    outfile << Asm::mov(eax, ptr(eax, get_attr_offset(Strings::Types::Int, Strings::Attributes::Val)));
+    outfile << Asm::mov(eax, ptr(eax, layout->get_attribute_offset(Symbols::Types::Int, Symbols::Attributes::Val)));
     outfile << Asm::pop(ebx);
     outfile << Asm::sub(ebx, eax);
     outfile << Asm::mov(eax, ebx);
     make_new_int_object(eax);
 }
 
-void MultiplicationNode::code() {
+void MultiplicationNode::emit_code() {
     get_first()->code();
-    outfile << Asm::mov(eax, ptr(eax, get_attr_offset(Strings::Types::Int, Strings::Attributes::Val)));
+    outfile << Asm::mov(eax, ptr(eax, layout->get_attribute_offset(Symbols::Types::Int, Symbols::Attributes::Val)));
     outfile << Asm::push(eax);
     get_second()->code();
-    outfile << Asm::mov(eax, ptr(eax, get_attr_offset(Strings::Types::Int, Strings::Attributes::Val)));
+    outfile << Asm::mov(eax, ptr(eax, layout->get_attribute_offset(Symbols::Types::Int, Symbols::Attributes::Val)));
     outfile << Asm::pop(ebx);
     outfile << Asm::imul(ebx);
     make_new_int_object(eax);
 }
 
-void DivisionNode::code() {
+void DivisionNode::emit_code() {
     get_first()->code();
-    outfile << Asm::mov(eax, ptr(eax, get_attr_offset(Strings::Types::Int, Strings::Attributes::Val)));
+    outfile << Asm::mov(eax, ptr(eax, layout->get_attribute_offset(Symbols::Types::Int, Symbols::Attributes::Val)));
     outfile << Asm::push(eax);
     get_second()->code();
-    outfile << Asm::mov(eax, ptr(eax, get_attr_offset(Strings::Types::Int, Strings::Attributes::Val)));
+    outfile << Asm::mov(eax, ptr(eax, layout->get_attribute_offset(Symbols::Types::Int, Symbols::Attributes::Val)));
     outfile << Asm::pop(ebx);
     outfile << Asm::xchg(eax, ebx);
     outfile << Asm::xor_(edx, edx);
@@ -534,12 +507,12 @@ void DivisionNode::code() {
     make_new_int_object(eax);
 }
 
-void LTNode::code() {
+void LTNode::emit_code() {
     get_first()->code();
-    outfile << Asm::mov(eax, ptr(eax, get_attr_offset(Strings::Types::Int, Strings::Attributes::Val)));
+    outfile << Asm::mov(eax, ptr(eax, layout->get_attribute_offset(Symbols::Types::Int, Symbols::Attributes::Val)));
     outfile << Asm::push(eax);
     get_second()->code();
-    outfile << Asm::mov(eax, ptr(eax, get_attr_offset(Strings::Types::Int, Strings::Attributes::Val)));
+    outfile << Asm::mov(eax, ptr(eax, layout->get_attribute_offset(Symbols::Types::Int, Symbols::Attributes::Val)));
     outfile << Asm::pop(ebx);
     outfile << Asm::cmp(eax, ebx);
     outfile << Asm::setg(al);
@@ -547,12 +520,12 @@ void LTNode::code() {
     make_new_bool_object(eax);
 }
 
-void LTENode::code() {
+void LTENode::emit_code() {
     get_first()->code();
-    outfile << Asm::mov(eax, ptr(eax, get_attr_offset(Strings::Types::Int, Strings::Attributes::Val)));
+    outfile << Asm::mov(eax, ptr(eax, layout->get_attribute_offset(Symbols::Types::Int, Symbols::Attributes::Val)));
     outfile << Asm::push(eax);
     get_second()->code();
-    outfile << Asm::mov(eax, ptr(eax, get_attr_offset(Strings::Types::Int, Strings::Attributes::Val)));
+    outfile << Asm::mov(eax, ptr(eax, layout->get_attribute_offset(Symbols::Types::Int, Symbols::Attributes::Val)));
     outfile << Asm::pop(ebx);
     outfile << Asm::cmp(eax, ebx);
     outfile << Asm::setge(al);
@@ -560,27 +533,27 @@ void LTENode::code() {
     make_new_bool_object(eax);
 }
 
-void EQNode::code() {
+void EQNode::emit_code() {
     outfile << "  ; equals expression" << std::endl;
-    std::string type = get_first()->get_checked_type();
+    Symbol type = get_first()->get_checked_type();
 
-    if (type == Strings::Types::String) {
+    if (type == Symbols::Types::String) {
         // comparing strings in assembly is different than comparing
         // bools and integers - we have to implement something
         // similar to C's strcmp()
         get_first()->code();
-        outfile << Asm::mov(eax, ptr(eax, get_attr_offset(Strings::Types::String, Strings::Attributes::StrField)));
+        outfile << Asm::mov(eax, ptr(eax, layout->get_attribute_offset(Symbols::Types::String, Symbols::Attributes::StrField)));
         outfile << Asm::push(eax);
         get_second()->code();
-        outfile << Asm::mov(eax, ptr(eax, get_attr_offset(Strings::Types::String, Strings::Attributes::StrField)));
+        outfile << Asm::mov(eax, ptr(eax, layout->get_attribute_offset(Symbols::Types::String, Symbols::Attributes::StrField)));
         outfile << Asm::push(eax);
         outfile << Asm::call("_strcmp");
-    } else if (type == Strings::Types::Int || type == Strings::Types::Bool) {
+    } else if (type == Symbols::Types::Int || type == Symbols::Types::Bool) {
         get_first()->code();
-        outfile << Asm::mov(eax, ptr(eax, get_attr_offset(type, Strings::Attributes::Val)));
+        outfile << Asm::mov(eax, ptr(eax, layout->get_attribute_offset(type, Symbols::Attributes::Val)));
         outfile << Asm::push(eax);
         get_second()->code();
-        outfile << Asm::mov(eax, ptr(eax, get_attr_offset(type, Strings::Attributes::Val)));
+        outfile << Asm::mov(eax, ptr(eax, layout->get_attribute_offset(type, Symbols::Attributes::Val)));
         outfile << Asm::pop(ebx);
         outfile << Asm::cmp(eax, ebx);
         outfile << Asm::setz(al);
@@ -599,9 +572,9 @@ void EQNode::code() {
     }
 }
 
-void ConditionalNode::code() {
+void ConditionalNode::emit_code() {
     get_predicate()->code();
-    outfile << Asm::mov(eax, ptr(eax, get_attr_offset(Strings::Types::Bool, Strings::Attributes::Val)));
+    outfile << Asm::mov(eax, ptr(eax, layout->get_attribute_offset(Symbols::Types::Bool, Symbols::Attributes::Val)));
     outfile << Asm::test(eax, eax);
 
     // if the value of the predicate is not zero, jump to the 'then' branch
@@ -614,11 +587,11 @@ void ConditionalNode::code() {
     outfile << Asm::label(unique_label(".cond_over", this));
 }
 
-void WhileNode::code() {
+void WhileNode::emit_code() {
     // execute the body in a loop until the predicate is false
     outfile << Asm::label(unique_label(".while_begin", this));
     get_predicate()->code();
-    outfile << Asm::mov(eax, ptr(eax, get_attr_offset(Strings::Types::Bool, Strings::Attributes::Val)));
+    outfile << Asm::mov(eax, ptr(eax, layout->get_attribute_offset(Symbols::Types::Bool, Symbols::Attributes::Val)));
     outfile << Asm::test(eax, eax);
     outfile << Asm::je(unique_label(".while_end", this));
     get_body()->code();
@@ -627,14 +600,14 @@ void WhileNode::code() {
     outfile << Asm::xor_(eax, eax);  // loops return void
 }
 
-void BlockNode::code() {
+void BlockNode::emit_code() {
     // simply evaluate all the expressions in order
     for (ExpressionNode* expression : get_expressions()) {
         expression->code();
     }
 }
 
-void CaseNode::code() {   
+void CaseNode::emit_code() {   
     uint i;
     get_target()->code();
 
@@ -649,7 +622,7 @@ void CaseNode::code() {
 
     i = 0;
     for (CaseBranchNode* branch : get_branches()) {
-        outfile << Asm::mov(ebx, ptr(branch->get_type() + "_proto"));
+        outfile << Asm::mov(ebx, ptr(branch->get_type().str() + "_proto"));
         outfile << Asm::cmp(ecx, ebx);
         outfile << Asm::je(unique_label(".case_branch_" + std::to_string(i++), this));
     }
@@ -682,9 +655,9 @@ void CaseNode::code() {
     outfile << Asm::add(esp, 4);  // remove the expr0 stack variable
 }
 
-void LetNode::code() {
+void LetNode::emit_code() {
     ExpressionNode* body = get_body();
-    std::vector<LetInitializerNode*> initializers = get_initializers();
+    NodeList<LetInitializerNode*> initializers = get_initializers();
 
     scope_stack.enter_scope();
 
@@ -699,18 +672,18 @@ void LetNode::code() {
     outfile << Asm::add(esp, initializers.size() * Constants::WordSize);
 }
 
-void LetInitializerNode::code() {
+void LetInitializerNode::emit_code() {
     get_expr()->code();
     outfile << Asm::push(eax);
     scope_stack.add_stack_variable(get_name());
 }
 
-void DispatchNode::code() {
+void DispatchNode::emit_code() {
     ExpressionNode* object = get_object();
-    std::string object_type = object->get_checked_type();
-    std::vector<ExpressionNode*> parameters = get_parameters();
+    Symbol object_type = object->get_checked_type();
+    NodeList<ExpressionNode*> parameters = get_parameters();
 
-    if (object_type == Strings::Types::SelfType) {
+    if (object_type == Symbols::Types::SelfType) {
         object_type = current_class;
     }
 
@@ -740,10 +713,10 @@ void DispatchNode::code() {
     outfile << Asm::mov(eax, ptr(eax, 12));
     
     // get the correct entry in the dispatch table
-    outfile << Asm::mov(eax, ptr(eax, get_method_offset(object_type, get_method_name())));
+    outfile << Asm::mov(eax, ptr(eax, layout->get_method_offset(object_type, get_method_name())));
 
     // overwrite the selfptr and execute the dispatch
-    std::string old_class = current_class;
+    Symbol old_class = current_class;
     current_class = object_type;
     outfile << Asm::mov(ptr(selfptr), ebx);
     outfile << Asm::call(eax);
@@ -754,17 +727,17 @@ void DispatchNode::code() {
     outfile << Asm::mov(ptr(selfptr), ebx);
 }
 
-void StaticDispatchNode::code() {
-    std::string static_type = get_static_type();
+void StaticDispatchNode::emit_code() {
+    Symbol static_type = get_static_type();
     ExpressionNode* object = get_object();
-    std::string object_type = object->get_checked_type();
+    Symbol object_type = object->get_checked_type();
 
     // save the old selfptr
     outfile << Asm::mov(eax, ptr(selfptr));
     outfile << Asm::push(eax);
     
     // pass the dispatch arguments in order
-    std::vector<ExpressionNode*> parameters = get_parameters();
+    NodeList<ExpressionNode*> parameters = get_parameters();
     for (auto it = parameters.begin(); it != parameters.end(); ++it) {
         ExpressionNode* parameter = *it;
         parameter->code();
@@ -783,10 +756,10 @@ void StaticDispatchNode::code() {
     outfile << Asm::mov(ebx, eax);
 
     // get the correct entry in the dispatch table of the specified static type
-    outfile << Asm::mov(eax, ptr(static_type + "_dispatch_table", get_method_offset(static_type, get_method_name())));
+    outfile << Asm::mov(eax, ptr(static_type.str() + "_dispatch_table", layout->get_method_offset(static_type, get_method_name())));
 
     // overwrite the selfptr and execute the dispatch
-    std::string old_class = current_class;
+    Symbol old_class = current_class;
     current_class = object_type;
     outfile << Asm::mov(ptr(selfptr), ebx);
     outfile << Asm::call(eax);
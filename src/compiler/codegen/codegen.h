@@ -3,17 +3,19 @@
 
 #include <fstream>
 #include <map>
+#include <memory>
 #include <string>
 #include <sstream>
 #include "asm.h"
 #include "classtag.h"
 #include "scope.h"
-#include "offsets.h"
+#include "../../common/class_layout.h"
 #include "builtins.h"
 #include "../../common/ast.h"
 #include "../../common/classtable.h"
 #include "../../common/consts.h"
 #include "../../utils/pretty_print.h"
+#include "../../utils/phase_timer.h"
 
 void generate_code(ProgramNode&, std::string, ClassTable*);
 
@@ -3,51 +3,41 @@
 
 #include <string>
 #include <vector>
-#include <map>
 #include <stdexcept>
 #include "asm.h"
 #include "../../common/ast.h"
 #include "../../common/consts.h"
+#include "../../common/symbol.h"
+#include "../../common/scoped_table.h"
 
 // objects: attributes, method parameters, let statements and case statements
 
-class Scope {
-    private:
-        uint stack_base = 0;
-        uint stack_offset = 0;
-        uint method_argument_counter = 0;
-        std::vector<std::pair<std::string, std::string>> objects;
-
-    public:
-        Scope(uint basis) : stack_base(basis) {}
-        void add_stack_variable(const std::string&);
-        void add_parameter(const std::string&);
-        void add_attribute(const std::string&, uint);
-        bool exists(const std::string&);
-        std::string get_location(const std::string&);
-
-        uint get_stack_offset() {
-            return stack_offset;
-        }
-
-        uint get_method_argument_counter() {
-            return method_argument_counter;
-        }
-};
-
 class ScopeStack {
     private:
-        std::vector<Scope*> scopes;
+        // where an object is stored, relative to the base pointer
+        // for stack variables and parameters, or to the self pointer
+        struct Location {
+            bool attribute = false;
+            int offset = 0;
+        };
+
+        struct Frame {
+            uint stack_base = 0;
+            uint stack_offset = 0;
+            uint method_argument_counter = 0;
+        };
+
+        ScopedTable<Location> objects;
+        std::vector<Frame> frames;
         uint stack_var_counter = 0;
-    
+
     public:
         void enter_scope();
         void exit_scope();
-        Scope* get_scope();
-        void add_stack_variable(const std::string&);
-        void add_parameter(const std::string&);
-        void add_attribute(const std::string&, uint);
-        std::string get_location(const std::string&);
+        void add_stack_variable(Symbol);
+        void add_parameter(Symbol);
+        void add_attribute(Symbol, uint);
+        std::string get_location(Symbol);
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,162 @@
+#ifndef KEYWORDS_H
+#define KEYWORDS_H
+
+#include <array>
+#include <string_view>
+#include "../../common/token.h"
+
+// keywords are case-insensitive and take priority over identifiers of the same length
+struct Keyword {
+    std::string_view name;  // lowercase spelling
+    TokenType type;
+    bool value;             // value of the boolean constants
+    bool lowercase_first;   // the boolean constants must begin with a lowercase letter
+};
+
+constexpr Keyword keyword_list[] = {
+    {"class", TokenType::CLASS, false, false},
+    {"if", TokenType::IF, false, false},
+    {"else", TokenType::ELSE, false, false},
+    {"fi", TokenType::FI, false, false},
+    {"in", TokenType::IN, false, false},
+    {"inherits", TokenType::INHERITS, false, false},
+    {"let", TokenType::LET, false, false},
+    {"loop", TokenType::LOOP, false, false},
+    {"pool", TokenType::POOL, false, false},
+    {"then", TokenType::THEN, false, false},
+    {"while", TokenType::WHILE, false, false},
+    {"case", TokenType::CASE, false, false},
+    {"esac", TokenType::ESAC, false, false},
+    {"of", TokenType::OF, false, false},
+    {"new", TokenType::NEW, false, false},
+    {"isvoid", TokenType::ISVOID, false, false},
+    {"not", TokenType::NOT, false, false},
+    {"true", TokenType::BOOL, true, true},
+    {"false", TokenType::BOOL, false, true}
+};
+
+constexpr size_t KeywordCount = sizeof(keyword_list) / sizeof(keyword_list[0]);
+constexpr size_t KeywordTableSize = 64;
+constexpr size_t MinKeywordLength = 2;
+constexpr size_t MaxKeywordLength = 8;
+
+// ORing in 0x20 lowercases letters and leaves digits alone,
+// underscores turn into a character that no keyword contains
+constexpr unsigned fold_case(char c) {
+    return static_cast<unsigned char>(c | 0x20);
+}
+
+// the hash only looks at the first and last character and the length
+constexpr size_t keyword_hash(unsigned seed, char first, char last, size_t length) {
+    return ((fold_case(first) * seed + fold_case(last)) ^ length) & (KeywordTableSize - 1);
+}
+
+constexpr bool is_perfect_keyword_hash(unsigned seed) {
+    bool used[KeywordTableSize] = {};
+
+    for (const Keyword& keyword : keyword_list) {
+        size_t slot = keyword_hash(seed, keyword.name.front(), keyword.name.back(), keyword.name.size());
+        if (used[slot]) {
+            return false;
+        }
+        used[slot] = true;
+    }
+
+    return true;
+}
+
+constexpr unsigned find_keyword_seed() {
+    for (unsigned seed = 1; seed < 1024; ++seed) {
+        if (is_perfect_keyword_hash(seed)) {
+            return seed;
+        }
+    }
+
+    return 0;
+}
+
+constexpr unsigned keyword_seed = find_keyword_seed();
+static_assert(keyword_seed != 0, "no perfect hash found for the keyword table");
+
+// maps each hash slot to an index in keyword_list, or -1 if the slot is empty
+constexpr std::array<signed char, KeywordTableSize> build_keyword_table() {
+    std::array<signed char, KeywordTableSize> table = {};
+
+    for (size_t i = 0; i < KeywordTableSize; ++i) {
+        table[i] = -1;
+    }
+
+    for (size_t i = 0; i < KeywordCount; ++i) {
+        const Keyword& keyword = keyword_list[i];
+        table[keyword_hash(keyword_seed, keyword.name.front(), keyword.name.back(), keyword.name.size())] = i;
+    }
+
+    return table;
+}
+
+constexpr std::array<signed char, KeywordTableSize> keyword_table = build_keyword_table();
+
+// returns the keyword spelled by the identifier, or nullptr if it is not a keyword
+constexpr const Keyword* find_keyword(const char* text, size_t length) {
+    if (length < MinKeywordLength || length > MaxKeywordLength) {
+        return nullptr;
+    }
+
+    int index = keyword_table[keyword_hash(keyword_seed, text[0], text[length - 1], length)];
+    if (index < 0) {
+        return nullptr;
+    }
+
+    const Keyword& keyword = keyword_list[index];
+    if (keyword.name.size() != length) {
+        return nullptr;
+    }
+
+    for (size_t i = 0; i < length; ++i) {
+        if (fold_case(text[i]) != static_cast<unsigned>(keyword.name[i])) {
+            return nullptr;
+        }
+    }
+
+    if (keyword.lowercase_first && text[0] != keyword.name[0]) {
+        return nullptr;
+    }
+
+    return &keyword;
+}
+
+// every keyword must be found in any case, except for the
+// first letter of the boolean constants, which must be lowercase
+constexpr bool check_keyword_table() {
+    for (const Keyword& keyword : keyword_list) {
+        if (keyword.name.size() < MinKeywordLength || keyword.name.size() > MaxKeywordLength) {
+            return false;
+        }
+
+        char upper[MaxKeywordLength] = {};
+        char capitalized[MaxKeywordLength] = {};
+        for (size_t i = 0; i < keyword.name.size(); ++i) {
+            upper[i] = keyword.name[i] - 'a' + 'A';
+            capitalized[i] = i == 0 ? upper[i] : keyword.name[i];
+        }
+
+        if (find_keyword(keyword.name.data(), keyword.name.size()) != &keyword) {
+            return false;
+        }
+
+        const Keyword* expected = keyword.lowercase_first ? nullptr : &keyword;
+        if (find_keyword(upper, keyword.name.size()) != expected ||
+            find_keyword(capitalized, keyword.name.size()) != expected) {
+            return false;
+        }
+    }
+
+    return find_keyword("tRUE", 4) == &keyword_list[KeywordCount - 2] &&
+           find_keyword("fALSE", 5) == &keyword_list[KeywordCount - 1] &&
+           find_keyword("classes", 7) == nullptr &&
+           find_keyword("i_", 2) == nullptr;
+}
+
+static_assert(check_keyword_table(), "keyword table does not classify its own keywords");
+
+#endif
@@ -2,75 +2,117 @@
 
 /*
  *  Lexical analyzer.
- *  
+ *
  *  This file implements a lexer using a state machine
  *  and returns a Tokenstream object.
+ *
+ *  The program is scanned in a single pass with a cursor. In the default
+ *  state, tokens are recognized by a hand-written DFA driven by a table
+ *  of character classes, so every character is inspected a constant number of times.
+ *  Comments, string literals and whitespace are skipped with the kernels in skip.cpp.
  */
 
-void Scanner::single_line_comment_scan(std::stringstream& program) {
-    for (;;) {
-        if (program.get() == '\n') {
-            line_number++;
-            state = DEFAULT_SCAN;
-            return;
-        }
+static constexpr std::array<CharClass, 256> build_char_classes() {
+    std::array<CharClass, 256> classes = {};
 
-        if (program.eof()) {
-            return;
-        }
+    for (int c = 'a'; c <= 'z'; ++c) classes[c] = LOWER_CHAR;
+    for (int c = 'A'; c <= 'Z'; ++c) classes[c] = UPPER_CHAR;
+    for (int c = '0'; c <= '9'; ++c) classes[c] = DIGIT_CHAR;
+
+    classes['_'] = UNDERSCORE_CHAR;
+
+    for (unsigned char c : { ' ', '\t', '\v', '\r', '\f', '\n' }) {
+        classes[c] = WHITESPACE_CHAR;
+    }
+
+    for (unsigned char c : { '+', '-', '*', '/', '<', '=', '(', ')', '{', '}', ':', ';', '.', ',', '@', '~' }) {
+        classes[c] = OPERATOR_CHAR;
     }
+
+    return classes;
+}
+
+static constexpr std::array<CharClass, 256> char_classes = build_char_classes();
+
+static CharClass char_class(char c) {
+    return char_classes[static_cast<unsigned char>(c)];
 }
 
-void Scanner::multi_line_comment_scan(std::stringstream& program) {
-    uint cursor = program.tellg();
-    std::string program_str = program.str();
+void Scanner::single_line_comment_scan() {
+    skip_to(kernels->line_comment(program + cursor, program_end(), line_number));
 
+    if (cursor >= program_length) {
+        eof = true;
+        return;
+    }
+
+    // consume the newline
+    cursor++;
+    line_number++;
+    state = DEFAULT_SCAN;
+}
+
+void Scanner::multi_line_comment_scan() {
     // COOL supports nested multi-line comments
     // this variable keeps track of the number of nested comments
     uint nested_count = 1;
 
-    std::smatch m;
-
     for (;;) {
-        if (program.eof()) {
+        // jump to the next '(' or '*', the only characters
+        // that can start a comment delimiter
+        skip_to(kernels->block_comment(program + cursor, program_end(), line_number));
+
+        if (cursor >= program_length) {
             error_message = "EOF in comment";
-            token_stream.add_token(std::make_shared<ErrorToken>(error_message, line_number));
+            token_stream->add_error(error_message, line_number);
+            eof = true;
             return;
         }
 
-        std::string next = program_str.substr(cursor);
-
-        if (std::regex_search(next, m, multi_line_comment_regex_open)) {
+        if (at(0, '(') && at(1, '*')) {
             nested_count++;
-            cursor += m.str().length();
-        } else if (std::regex_search(next, m, multi_line_comment_regex_close)) {
+            cursor += 2;
+        } else if (at(0, '*') && at(1, ')')) {
             nested_count--;
-            cursor += m.str().length();
-        } else if (program_str[cursor++] == '\n') {
-            line_number++;
+            cursor += 2;
+        } else {
+            cursor++;
         }
 
         if (nested_count == 0) {
-            program.seekg(cursor);
             state = DEFAULT_SCAN;
             return;
         }
-
-        program.seekg(cursor); program.get();  // trigger eof
     }
 }
 
-void Scanner::string_scan(std::stringstream& program) {
+void Scanner::string_scan() {
     for (;;) {
-        char c = program.get();
+        // ordinary characters are skipped in bulk, but never so many that
+        // the string becomes too long; the length check below handles that.
+        // string_length() leaves out the character just read, so the
+        // characters consumed so far are counted here instead
+        size_t consumed = string_materialized ? string_builder.length() : cursor - string_start;
+        size_t budget = Constants::MaxStringSize - std::min<size_t>(consumed, Constants::MaxStringSize);
+        const char* limit = program + std::min(program_length, cursor + budget);
+        const char* next = kernels->string_body(program + cursor, limit, line_number);
+
+        if (string_materialized) {
+            string_builder.append(program + cursor, next - (program + cursor));
+        }
 
-        if (program.eof()) {
+        skip_to(next);
+
+        if (cursor >= program_length) {
             error_message = "EOF in string constant";
-            token_stream.add_token(std::make_shared<ErrorToken>(error_message, line_number));
+            token_stream->add_error(error_message, line_number);
+            eof = true;
             return;
         }
 
-        if (string_builder.length() + 1 > Constants::MaxStringSize) {
+        char c = program[cursor++];
+
+        if (string_length() + 1 > Constants::MaxStringSize) {
             error_message = "String constant too long";
             string_builder = "";
             state = BROKEN_STRING_SCAN;
@@ -78,12 +120,22 @@ void Scanner::string_scan(std::stringstream& program) {
         }
 
         if (c == '"') {
-            StringToken token = StringToken(string_builder, line_number);
-            token_stream.add_token(std::make_shared<StringToken>(string_builder, line_number));
+            if (string_materialized) {
+                token_stream->add_string(std::move(string_builder), line_number);
+            } else {
+                std::string_view value(program + string_start, string_length());
+                token_stream->add_lexeme(TokenType::STRING, value, line_number);
+            }
             string_builder = "";
             state = DEFAULT_SCAN;
             return;
         } else if (c == '\\') {
+            if (!string_materialized) {
+                // copy everything up to the backslash, the rest
+                // of the literal is built character by character
+                string_builder.assign(program + string_start, string_length());
+                string_materialized = true;
+            }
             state = ESCAPED_STRING_SCAN;
             return;
         } else if (c == '\n') {
@@ -96,21 +148,22 @@ void Scanner::string_scan(std::stringstream& program) {
             error_message = "String contains null character.";
             state = BROKEN_STRING_SCAN;
             return;
-        } else {
+        } else if (string_materialized) {
             string_builder += c;
         }
     }
 }
 
-void Scanner::escaped_string_scan(std::stringstream& program) {
-    char c = program.get();
-
-    if (program.eof()) {
+void Scanner::escaped_string_scan() {
+    if (cursor >= program_length) {
         error_message = "EOF in string constant";
-        token_stream.add_token(std::make_shared<ErrorToken>(error_message, line_number));
+        token_stream->add_error(error_message, line_number);
+        eof = true;
         return;
     }
 
+    char c = program[cursor++];
+
     switch (c) {
         case '\0':
             error_message = "String contains escaped null character.";
@@ -140,14 +193,26 @@ void Scanner::escaped_string_scan(std::stringstream& program) {
     state = STRING_SCAN;
 }
 
-void Scanner::broken_string_scan(std::stringstream& program) {
+void Scanner::broken_string_scan() {
     // error state for recovering from broken strings
     // this state doesn't output anything, it just consumes input
     // and returns to the default state when approriate
     bool escaped = false;
-    
+
     for (;;) {
-        char c = program.get();
+        const char* next = kernels->broken_string(program + cursor, program_end(), line_number);
+
+        if (next != program + cursor) {
+            escaped = false;
+            skip_to(next);
+        }
+
+        if (cursor >= program_length) {
+            eof = true;
+            return;
+        }
+
+        char c = program[cursor++];
         switch (c) {
             case '\\':
                 escaped = true;
@@ -169,145 +234,314 @@ void Scanner::broken_string_scan(std::stringstream& program) {
     }
 }
 
-void Scanner::default_scan(std::stringstream& program) {
-    int cursor = program.tellg();
-    std::string program_str = program.str();
-    std::string next = program_str.substr(cursor);
-
-    // ignore whitespace 
-    std::smatch whitespace_match;
-    if (std::regex_search(next, whitespace_match, whitespace_regex)) {
-        std::string match_str = whitespace_match.str();
-        line_number += std::count(match_str.begin(), match_str.end(), '\n');
-        program.seekg(cursor += match_str.length());
-        next = program_str.substr(cursor);
+void Scanner::operator_scan() {
+    // operators are at most two characters long, so a single
+    // character of lookahead is enough to find the longest match
+    TokenType token_type;
+    size_t length = 1;
+
+    switch (program[cursor]) {
+        case '+': token_type = TokenType::PLUS; break;
+        case '-': token_type = TokenType::MINUS; break;
+        case '*': token_type = TokenType::MULTIPLICATION; break;
+        case '/': token_type = TokenType::DIVISION; break;
+        case '(': token_type = TokenType::PARENTHESIS_OPEN; break;
+        case ')': token_type = TokenType::PARENTHESIS_CLOSE; break;
+        case '{': token_type = TokenType::CURLY_BRACKET_OPEN; break;
+        case '}': token_type = TokenType::CURLY_BRACKET_CLOSE; break;
+        case ':': token_type = TokenType::COLON; break;
+        case ';': token_type = TokenType::SEMICOLON; break;
+        case '.': token_type = TokenType::DOT; break;
+        case ',': token_type = TokenType::COMMA; break;
+        case '@': token_type = TokenType::AT; break;
+        case '~': token_type = TokenType::SQUIGGLE; break;
+
+        case '<':
+            if (at(1, '=')) {
+                token_type = TokenType::LTE;
+                length = 2;
+            } else if (at(1, '-')) {
+                token_type = TokenType::ASSIGN;
+                length = 2;
+            } else {
+                token_type = TokenType::LT;
+            }
+            break;
+
+        default:
+            if (at(1, '>')) {
+                token_type = TokenType::ARROW;
+                length = 2;
+            } else {
+                token_type = TokenType::EQ;
+            }
+            break;
+    }
+
+    token_stream->add_token(token_type, line_number);
+    cursor += length;
+}
+
+void Scanner::identifier_scan() {
+    size_t start = cursor;
+
+    // identifiers extend as far as possible, so the
+    // match always ends on a word boundary
+    for (cursor++; cursor < program_length; ++cursor) {
+        CharClass cc = char_class(program[cursor]);
+        if (cc != LOWER_CHAR && cc != UPPER_CHAR && cc != DIGIT_CHAR && cc != UNDERSCORE_CHAR) {
+            break;
+        }
+    }
+
+    const char* text = program + start;
+    size_t length = cursor - start;
+
+    // keywords, including the boolean constants, are classified
+    // with a perfect hash built at compile time (see keywords.h)
+    if (const Keyword* keyword = find_keyword(text, length)) {
+        if (keyword->type == TokenType::BOOL) {
+            token_stream->add_bool(keyword->value, line_number);
+        } else {
+            token_stream->add_token(keyword->type, line_number);
+        }
+    } else if (char_class(text[0]) == UPPER_CHAR) {
+        token_stream->add_symbol(TokenType::TYPE_IDENTIFIER, std::string_view(text, length), line_number);
+    } else {
+        token_stream->add_symbol(TokenType::OBJ_IDENTIFIER, std::string_view(text, length), line_number);
+    }
+}
+
+void Scanner::integer_scan() {
+    size_t start = cursor;
+
+    while (cursor < program_length && char_class(program[cursor]) == DIGIT_CHAR) {
+        cursor++;
+    }
+
+    token_stream->add_lexeme(TokenType::INTEGER, std::string_view(program + start, cursor - start), line_number);
+}
+
+void Scanner::default_scan() {
+    // ignore whitespace
+    if (cursor < program_length && char_class(program[cursor]) == WHITESPACE_CHAR) {
+        skip_to(kernels->whitespace(program + cursor, program_end(), line_number));
+    }
+
+    if (cursor >= program_length) {
+        eof = true;
+        return;
     }
 
     // first, check for strings and comments
     // these are the characters that cause a state transition
-    std::smatch m;
-    if (std::regex_search(next, m, single_line_comment_regex)) {
-        state = SINGLE_LINE_COMMENT_SCAN; 
-        program.seekg(cursor + m.str().length());
+    if (at(0, '-') && at(1, '-')) {
+        state = SINGLE_LINE_COMMENT_SCAN;
+        cursor += 2;
         return;
-    } else if (std::regex_search(next, m, multi_line_comment_regex_open)) {
+    } else if (at(0, '(') && at(1, '*')) {
         state = MULTI_LINE_COMMENT_SCAN;
-        program.seekg(cursor + m.str().length());
+        cursor += 2;
         return;
-    } else if (std::regex_search(next, m, quotation_mark_regex)) {
+    } else if (at(0, '"')) {
         state = STRING_SCAN;
-        program.seekg(cursor + m.str().length());
+        string_builder = "";
+        string_materialized = false;
+        string_start = ++cursor;
         return;
-    } else if (std::regex_search(next, m, multi_line_comment_regex_close)) {
+    } else if (at(0, '*') && at(1, ')')) {
         error_message = "Unmatched *)";
         state = SCAN_ERROR;
-        program.seekg(cursor + m.str().length());
+        cursor += 2;
         return;
     }
 
     // otherwise, identify tokens as normal
-    std::list<std::pair<std::smatch, TokenType> > matches;
+    switch (char_class(program[cursor])) {
+        case LOWER_CHAR:
+        case UPPER_CHAR:
+            identifier_scan();
+            break;
 
-    // find all matches
-    for (auto pattern : patterns) {
-        std::regex regex = pattern.second;
-        std::smatch match;
+        case DIGIT_CHAR:
+            integer_scan();
+            break;
 
-        if (std::regex_search(next, match, regex)) {
-            matches.push_back(std::make_pair(match, pattern.first));
-        }
+        case OPERATOR_CHAR:
+            operator_scan();
+            break;
+
+        default:
+            // handle invalid token
+            error_message = std::string(1, program[cursor++]);
+            state = SCAN_ERROR;
+            break;
     }
+}
 
-    // handle invalid token
-    if (matches.empty()) {
-        // no match found
-        error_message = program.get();
-        state = SCAN_ERROR;
-        return;
+void Scanner::reset(std::string_view source, Tokenstream& output) {
+    // tokens refer into the source, so it must outlive the token stream
+    token_stream = &output;
+    program = source.data();
+    program_length = source.size();
+    cursor = 0;
+    eof = false;
+    line_number = 1;
+    state = DEFAULT_SCAN;
+    kernels = &get_skip_kernels();
+}
+
+bool Scanner::step() {
+    // run the state machine once, returns false at the end of input
+    if (eof) {
+        return false;
     }
 
-    // get the longest match 
-    auto token_match = std::max_element(matches.begin(), matches.end(), 
-        [](const auto& a, const auto& b) {
-            int len_a = a.first.str().length();
-            int len_b = b.first.str().length();
+    switch (state) {
+        case SINGLE_LINE_COMMENT_SCAN:
+            single_line_comment_scan();
+            break;
 
-            // note: token type will be used as a tie-breaker
-            return len_a < len_b;
-        });
+        case MULTI_LINE_COMMENT_SCAN:
+            multi_line_comment_scan();
+            break;
 
+        case STRING_SCAN:
+            string_scan();
+            break;
 
-    // add token to token stream
-    std::smatch match = token_match->first;
-    TokenType token_type = token_match->second;
-    int length = match.str().length();
+        case ESCAPED_STRING_SCAN:
+            escaped_string_scan();
+            break;
 
-    switch (token_type) {
-        case TokenType::BOOL: {
-            bool value = match.str()[0] == 't';
-            token_stream.add_token(std::make_shared<BoolToken>(value, line_number));
+        case BROKEN_STRING_SCAN:
+            token_stream->add_error(error_message, line_number);
+            broken_string_scan();
             break;
-        }
 
-        case TokenType::INTEGER: {
-            token_stream.add_token(std::make_shared<IntToken>(match.str(), line_number));
+        case SCAN_ERROR:
+            token_stream->add_error(error_message, line_number);
+            state = DEFAULT_SCAN;
             break;
-        }
 
-        case TokenType::TYPE_IDENTIFIER: {
-            token_stream.add_token(std::make_shared<TypeIdToken>(match.str(), line_number));
+        default:
+            default_scan();
             break;
+    }
+
+    return !eof;
+}
+
+void Scanner::scan_until(size_t stop) {
+    // scan until the stop position is reached in the default state;
+    // only strings and comments can carry the scan past it
+    for (;;) {
+        if (state == DEFAULT_SCAN && cursor < std::min(stop, program_length) && char_class(program[cursor]) == WHITESPACE_CHAR) {
+            // whitespace before the stop position belongs to this chunk
+            skip_to(kernels->whitespace(program + cursor, program + std::min(stop, program_length), line_number));
         }
 
-        case TokenType::OBJ_IDENTIFIER: {
-            token_stream.add_token(std::make_shared<ObjIdToken>(match.str(), line_number));
-            break;
+        if ((state == DEFAULT_SCAN && cursor >= stop) || !step()) {
+            return;
         }
+    }
+}
 
-        default: {
-            token_stream.add_token(std::make_shared<Token>(token_type, line_number));
-            break;
+static size_t chunk_boundary(std::string_view source, size_t from) {
+    // chunks start at the beginning of a line that does not start with
+    // whitespace, so no token can span the boundary
+    for (size_t i = from; i + 1 < source.size(); ++i) {
+        if (source[i] == '\n' && char_class(source[i + 1]) != WHITESPACE_CHAR) {
+            return i + 1;
         }
     }
 
-    program.seekg(cursor + length);
+    return source.size();
 }
 
-Tokenstream Scanner::scan(std::stringstream& program) {
-    while (!program.eof()) {
-
-        switch (state) {
-            case SINGLE_LINE_COMMENT_SCAN:
-                single_line_comment_scan(program);
-                break;
+Tokenstream Scanner::scan_parallel(std::string_view source, size_t chunks) {
+    std::vector<size_t> starts = { 0 };
+    for (size_t i = 1; i < chunks; ++i) {
+        size_t boundary = chunk_boundary(source, std::max(i * (source.size() / chunks), starts.back() + 1));
+        if (boundary >= source.size()) {
+            break;
+        }
+        starts.push_back(boundary);
+    }
 
-            case MULTI_LINE_COMMENT_SCAN:
-                multi_line_comment_scan(program);
-                break;
+    struct Chunk {
+        Tokenstream ts;
+        size_t end = 0;
+        uint line_number = 1;
+    };
+
+    // each chunk is lexed as if it started in the default state on line 1
+    auto lex_chunk = [&](Chunk& chunk, size_t start, size_t stop) {
+        Scanner scanner;
+        chunk.ts.use_local_symbols();
+        scanner.reset(source, chunk.ts);
+        scanner.cursor = start;
+        scanner.scan_until(stop);
+        chunk.end = scanner.cursor;
+        chunk.line_number = scanner.line_number;
+    };
+
+    auto stop = [&](size_t i) {
+        return i + 1 < starts.size() ? starts[i + 1] : SIZE_MAX;
+    };
+
+    std::vector<Chunk> results(starts.size());
+    std::vector<std::thread> workers;
+
+    for (size_t i = 1; i < starts.size(); ++i) {
+        workers.emplace_back(lex_chunk, std::ref(results[i]), starts[i], stop(i));
+    }
+    lex_chunk(results[0], starts[0], stop(0));
 
-            case STRING_SCAN:
-                string_scan(program);
-                break;
-            
-            case ESCAPED_STRING_SCAN:
-                escaped_string_scan(program);
-                break;
-            
-            case BROKEN_STRING_SCAN:
-                token_stream.add_token(std::make_shared<ErrorToken>(error_message, line_number));            
-                broken_string_scan(program);
-                break;
-            
-            case SCAN_ERROR:
-                token_stream.add_token(std::make_shared<ErrorToken>(error_message, line_number));
-                state = DEFAULT_SCAN;
-                break;
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
 
-            default:
-                default_scan(program);
-                break;
+    // the chunks are joined in order, shifting their line numbers
+    std::vector<Chunk> retries(starts.size());
+    std::vector<Tokenstream*> parts;
+    std::vector<uint> line_offsets;
+    size_t position = 0;
+    uint line_number = 1;
+
+    for (size_t i = 0; i < starts.size(); ++i) {
+        Chunk* chunk = &results[i];
+
+        if (starts[i] != position) {
+            // the previous chunk ended inside a string or comment that ran
+            // past the start of this chunk, so the speculative result is wrong
+            lex_chunk(retries[i], position, stop(i));
+            chunk = &retries[i];
         }
+
+        parts.push_back(&chunk->ts);
+        line_offsets.push_back(line_number - 1);
+        line_number += chunk->line_number - 1;
+        position = chunk->end;
     }
 
-    return this->token_stream;
+    Tokenstream ts;
+    ts.join(parts, line_offsets);
+    return ts;
+}
+
+Tokenstream Scanner::scan(std::string_view source, uint jobs) {
+    // large programs are split into chunks that are lexed in parallel
+    size_t chunks = std::min<size_t>(jobs, source.size() / Constants::MinLexChunkSize);
+    if (chunks > 1) {
+        return scan_parallel(source, chunks);
+    }
+
+    Tokenstream ts;
+    reset(source, ts);
+
+    while (step()) {}
+
+    token_stream = nullptr;
+    return ts;
 }
\ No newline at end of file
@@ -1,66 +1,31 @@
 #ifndef LEXER_H
 #define LEXER_H
 
-#include <sstream>
-#include <list>
-#include <regex>
-#include <map>
+#include <string>
+#include <string_view>
+#include <array>
+#include <algorithm>
+#include <vector>
+#include <thread>
 #include "../../common/consts.h"
 #include "../../common/token.h"
+#include "skip.h"
+#include "keywords.h"
 
-// regex expressions for each type of token
-static const std::map<TokenType, std::regex> patterns = {
-    {TokenType::CLASS, std::regex("^class\\b", std::regex_constants::icase)},
-    {TokenType::IF, std::regex("^if\\b", std::regex_constants::icase)},
-    {TokenType::ELSE, std::regex("^else\\b", std::regex_constants::icase)},
-    {TokenType::FI, std::regex("^fi\\b", std::regex_constants::icase)},
-    {TokenType::IN, std::regex("^in\\b", std::regex_constants::icase)},
-    {TokenType::INHERITS, std::regex("^inherits\\b", std::regex_constants::icase)},
-    {TokenType::LET, std::regex("^let\\b", std::regex_constants::icase)},
-    {TokenType::LOOP, std::regex("^loop\\b", std::regex_constants::icase)},
-    {TokenType::POOL, std::regex("^pool\\b", std::regex_constants::icase)},
-    {TokenType::THEN, std::regex("^then\\b", std::regex_constants::icase)},
-    {TokenType::WHILE, std::regex("^while\\b", std::regex_constants::icase)},
-    {TokenType::CASE, std::regex("^case\\b", std::regex_constants::icase)},
-    {TokenType::ESAC, std::regex("^esac\\b", std::regex_constants::icase)},
-    {TokenType::OF, std::regex("^of\\b", std::regex_constants::icase)},
-    {TokenType::NEW, std::regex("^new\\b", std::regex_constants::icase)},
-    {TokenType::ISVOID, std::regex("^isvoid\\b", std::regex_constants::icase)},
-    {TokenType::NOT, std::regex("^not\\b", std::regex_constants::icase)},
-    {TokenType::OBJ_IDENTIFIER, std::regex("^[a-z][a-zA-Z0-9_]*\\b")},
-    {TokenType::TYPE_IDENTIFIER, std::regex("^[A-Z][a-zA-Z0-9_]*\\b")},
-    {TokenType::INTEGER, std::regex("^[0-9]+")},
-    {TokenType::BOOL, std::regex("^(t[rR][uU][eE]|f[aA][lL][sS][eE])\\b")},
-    {TokenType::PLUS, std::regex("^\\+")},
-    {TokenType::MINUS, std::regex("^-")},
-    {TokenType::MULTIPLICATION, std::regex("^\\*")},
-    {TokenType::DIVISION, std::regex("^\\/")},
-    {TokenType::LT, std::regex("^<")},
-    {TokenType::EQ, std::regex("^=")},
-    {TokenType::LTE, std::regex("^<=")},
-    {TokenType::PARENTHESIS_OPEN, std::regex("^\\(")},
-    {TokenType::PARENTHESIS_CLOSE, std::regex("^\\)")},
-    {TokenType::CURLY_BRACKET_OPEN, std::regex("^\\{")},
-    {TokenType::CURLY_BRACKET_CLOSE, std::regex("^\\}")},
-    {TokenType::COLON, std::regex("^:")},
-    {TokenType::SEMICOLON, std::regex("^;")},
-    {TokenType::DOT, std::regex("^\\.")},
-    {TokenType::COMMA, std::regex("^,")},
-    {TokenType::AT, std::regex("^@")},
-    {TokenType::SQUIGGLE, std::regex("^~")},
-    {TokenType::ARROW, std::regex("^=>")},
-    {TokenType::ASSIGN, std::regex("^<-")}
+// character classes used by the default scanner state
+enum CharClass : unsigned char {
+    INVALID_CHAR,
+    WHITESPACE_CHAR,
+    LOWER_CHAR,
+    UPPER_CHAR,
+    DIGIT_CHAR,
+    UNDERSCORE_CHAR,
+    OPERATOR_CHAR
 };
 
-static const std::regex whitespace_regex                = std::regex("^[ \t\v\r\f\n]+");
-static const std::regex single_line_comment_regex       = std::regex("^--");
-static const std::regex multi_line_comment_regex_open   = std::regex("^\\(\\*");
-static const std::regex multi_line_comment_regex_close  = std::regex("^\\*\\)");
-static const std::regex quotation_mark_regex            = std::regex("^\\\"");
-
 enum LexState {
     DEFAULT_SCAN,
-    SINGLE_LINE_COMMENT_SCAN, 
+    SINGLE_LINE_COMMENT_SCAN,
     MULTI_LINE_COMMENT_SCAN,
     STRING_SCAN,
     ESCAPED_STRING_SCAN,
@@ -70,21 +35,62 @@ enum LexState {
 
 class Scanner {
     private:
-        Tokenstream token_stream;
+        Tokenstream* token_stream = nullptr;
         uint line_number = 1;
         std::string string_builder = "";
         std::string error_message;
         LexState state = DEFAULT_SCAN;
 
-        void single_line_comment_scan(std::stringstream&);
-        void multi_line_comment_scan(std::stringstream&);
-        void string_scan(std::stringstream&);
-        void escaped_string_scan(std::stringstream&);
-        void broken_string_scan(std::stringstream&);
-        void default_scan(std::stringstream&);
-    
+        // the program is scanned in place using a cursor
+        const char* program = nullptr;
+        size_t program_length = 0;
+        size_t cursor = 0;
+        bool eof = false;
+
+        // kernels for skipping over comments, strings and whitespace
+        const SkipKernels* kernels = nullptr;
+
+        const char* program_end() {
+            return program + program_length;
+        }
+
+        void skip_to(const char* p) {
+            cursor = p - program;
+        }
+
+        // string literals are only copied into the string builder
+        // once an escape sequence is encountered
+        size_t string_start = 0;
+        bool string_materialized = false;
+
+        size_t string_length() {
+            return string_materialized ? string_builder.length() : cursor - 1 - string_start;
+        }
+
+        bool at(size_t offset, char c) {
+            return cursor + offset < program_length && program[cursor + offset] == c;
+        }
+
+        void single_line_comment_scan();
+        void multi_line_comment_scan();
+        void string_scan();
+        void escaped_string_scan();
+        void broken_string_scan();
+        void default_scan();
+        void operator_scan();
+        void identifier_scan();
+        void integer_scan();
+
+        // used for lexing large programs in parallel chunks
+        void scan_until(size_t);
+        Tokenstream scan_parallel(std::string_view, size_t);
+
     public:
-        Tokenstream scan(std::stringstream&);
+        Tokenstream scan(std::string_view, uint jobs = 1);
+
+        // incremental interface used when tokens are produced on demand
+        void reset(std::string_view, Tokenstream&);
+        bool step();
 };
 
-#endif
\ No newline at end of file
+#endif
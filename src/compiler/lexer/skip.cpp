@@ -0,0 +1,236 @@
+#include "skip.h"
+
+/*
+ *  Skip kernels for the lexer.
+ *
+ *  Most of the input inside comments, string literals and whitespace runs is
+ *  uninteresting to the lexer. The kernels in this file find the next byte that
+ *  the scanner has to look at, 16 or 32 bytes at a time when SSE2 or AVX2 is
+ *  available, while counting the newlines they skip over.
+ *
+ *  The implementation is selected once at startup based on the CPU.
+ *  Setting COOLR_SIMD to scalar, sse2 or avx2 forces a specific implementation.
+ */
+
+// each matcher describes the bytes a kernel stops at
+struct LineCommentMatch {
+    static bool scalar(char c) {
+        return c == '\n';
+    }
+
+#ifdef SKIP_X86
+    static __m128i sse2(__m128i v) {
+        return _mm_cmpeq_epi8(v, _mm_set1_epi8('\n'));
+    }
+
+    __attribute__((target("avx2")))
+    static __m256i avx2(__m256i v) {
+        return _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n'));
+    }
+#endif
+};
+
+struct BlockCommentMatch {
+    static bool scalar(char c) {
+        return c == '(' || c == '*';
+    }
+
+#ifdef SKIP_X86
+    static __m128i sse2(__m128i v) {
+        return _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('(')),
+                            _mm_cmpeq_epi8(v, _mm_set1_epi8('*')));
+    }
+
+    __attribute__((target("avx2")))
+    static __m256i avx2(__m256i v) {
+        return _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('(')),
+                               _mm256_cmpeq_epi8(v, _mm256_set1_epi8('*')));
+    }
+#endif
+};
+
+struct BrokenStringMatch {
+    static bool scalar(char c) {
+        return c == '"' || c == '\\' || c == '\n';
+    }
+
+#ifdef SKIP_X86
+    static __m128i sse2(__m128i v) {
+        return _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('"')),
+                                         _mm_cmpeq_epi8(v, _mm_set1_epi8('\\'))),
+                            _mm_cmpeq_epi8(v, _mm_set1_epi8('\n')));
+    }
+
+    __attribute__((target("avx2")))
+    static __m256i avx2(__m256i v) {
+        return _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('"')),
+                                               _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\'))),
+                               _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n')));
+    }
+#endif
+};
+
+struct StringBodyMatch {
+    static bool scalar(char c) {
+        return BrokenStringMatch::scalar(c) || c == '\0';
+    }
+
+#ifdef SKIP_X86
+    static __m128i sse2(__m128i v) {
+        return _mm_or_si128(BrokenStringMatch::sse2(v),
+                            _mm_cmpeq_epi8(v, _mm_setzero_si128()));
+    }
+
+    __attribute__((target("avx2")))
+    static __m256i avx2(__m256i v) {
+        return _mm256_or_si256(BrokenStringMatch::avx2(v),
+                               _mm256_cmpeq_epi8(v, _mm256_setzero_si256()));
+    }
+#endif
+};
+
+struct WhitespaceMatch {
+    // whitespace is ' ' and the range '\t' to '\r'
+    static bool scalar(char c) {
+        return c != ' ' && static_cast<unsigned char>(c - '\t') > '\r' - '\t';
+    }
+
+#ifdef SKIP_X86
+    static __m128i sse2(__m128i v) {
+        __m128i offset = _mm_sub_epi8(v, _mm_set1_epi8('\t'));
+        __m128i in_range = _mm_cmpeq_epi8(_mm_min_epu8(offset, _mm_set1_epi8('\r' - '\t')), offset);
+        __m128i whitespace = _mm_or_si128(in_range, _mm_cmpeq_epi8(v, _mm_set1_epi8(' ')));
+        return _mm_xor_si128(whitespace, _mm_set1_epi8(-1));
+    }
+
+    __attribute__((target("avx2")))
+    static __m256i avx2(__m256i v) {
+        __m256i offset = _mm256_sub_epi8(v, _mm256_set1_epi8('\t'));
+        __m256i in_range = _mm256_cmpeq_epi8(_mm256_min_epu8(offset, _mm256_set1_epi8('\r' - '\t')), offset);
+        __m256i whitespace = _mm256_or_si256(in_range, _mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')));
+        return _mm256_xor_si256(whitespace, _mm256_set1_epi8(-1));
+    }
+#endif
+};
+
+template<typename Match>
+static const char* skip_scalar(const char* p, const char* end, uint& newlines) {
+    for (; p < end; ++p) {
+        if (Match::scalar(*p)) {
+            return p;
+        }
+
+        if (*p == '\n') {
+            newlines++;
+        }
+    }
+
+    return end;
+}
+
+#ifdef SKIP_X86
+template<typename Match>
+static const char* skip_sse2(const char* p, const char* end, uint& newlines) {
+    const __m128i newline = _mm_set1_epi8('\n');
+
+    while (end - p >= 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        unsigned stop = _mm_movemask_epi8(Match::sse2(v));
+        unsigned lines = _mm_movemask_epi8(_mm_cmpeq_epi8(v, newline));
+
+        if (stop) {
+            // only count the newlines before the stop byte
+            unsigned i = __builtin_ctz(stop);
+            newlines += __builtin_popcount(lines & ((1u << i) - 1));
+            return p + i;
+        }
+
+        newlines += __builtin_popcount(lines);
+        p += 16;
+    }
+
+    // the last few bytes are handled one at a time
+    return skip_scalar<Match>(p, end, newlines);
+}
+
+template<typename Match>
+__attribute__((target("avx2,popcnt")))
+static const char* skip_avx2(const char* p, const char* end, uint& newlines) {
+    const __m256i newline = _mm256_set1_epi8('\n');
+
+    while (end - p >= 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        unsigned stop = _mm256_movemask_epi8(Match::avx2(v));
+        unsigned lines = _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, newline));
+
+        if (stop) {
+            unsigned i = __builtin_ctz(stop);
+            newlines += __builtin_popcount(lines & ((1u << i) - 1));
+            return p + i;
+        }
+
+        newlines += __builtin_popcount(lines);
+        p += 32;
+    }
+
+    return skip_sse2<Match>(p, end, newlines);
+}
+#endif
+
+static const SkipKernels scalar_kernels = {
+    "scalar",
+    skip_scalar<LineCommentMatch>,
+    skip_scalar<BlockCommentMatch>,
+    skip_scalar<StringBodyMatch>,
+    skip_scalar<BrokenStringMatch>,
+    skip_scalar<WhitespaceMatch>
+};
+
+#ifdef SKIP_X86
+static const SkipKernels sse2_kernels = {
+    "sse2",
+    skip_sse2<LineCommentMatch>,
+    skip_sse2<BlockCommentMatch>,
+    skip_sse2<StringBodyMatch>,
+    skip_sse2<BrokenStringMatch>,
+    skip_sse2<WhitespaceMatch>
+};
+
+static const SkipKernels avx2_kernels = {
+    "avx2",
+    skip_avx2<LineCommentMatch>,
+    skip_avx2<BlockCommentMatch>,
+    skip_avx2<StringBodyMatch>,
+    skip_avx2<BrokenStringMatch>,
+    skip_avx2<WhitespaceMatch>
+};
+#endif
+
+static const SkipKernels& select_skip_kernels() {
+#ifdef SKIP_X86
+    bool has_sse2 = __builtin_cpu_supports("sse2");
+    bool has_avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt");
+
+    // the environment can only pick an implementation the CPU supports
+    if (const char* forced = std::getenv("COOLR_SIMD")) {
+        if (std::strcmp(forced, "scalar") == 0) {
+            return scalar_kernels;
+        } else if (std::strcmp(forced, "sse2") == 0 && has_sse2) {
+            return sse2_kernels;
+        }
+    }
+
+    if (has_avx2) {
+        return avx2_kernels;
+    } else if (has_sse2) {
+        return sse2_kernels;
+    }
+#endif
+
+    return scalar_kernels;
+}
+
+const SkipKernels& get_skip_kernels() {
+    static const SkipKernels& kernels = select_skip_kernels();
+    return kernels;
+}
@@ -0,0 +1,28 @@
+#ifndef SKIP_H
+#define SKIP_H
+
+#include <string>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SKIP_X86
+#include <immintrin.h>
+#endif
+
+// a skip kernel returns a pointer to the first interesting byte in [begin, end),
+// or end if there is none. newlines in the skipped bytes are added to the counter
+typedef const char* (*SkipKernel)(const char*, const char*, uint&);
+
+struct SkipKernels {
+    const char* name;
+    SkipKernel line_comment;    // stops at '\n'
+    SkipKernel block_comment;   // stops at '(' and '*'
+    SkipKernel string_body;     // stops at '"', '\\', '\n' and NUL
+    SkipKernel broken_string;   // stops at '"', '\\' and '\n'
+    SkipKernel whitespace;      // stops at anything but whitespace
+};
+
+const SkipKernels& get_skip_kernels();
+
+#endif
@@ -9,7 +9,7 @@
 
 bool Parser::peek_equals(Tokenstream& ts, TokenType type) {
     // check if the next token in the stream matches the supplied type
-    Token* t = ts.peek();
+    const Token* t = ts.peek();
 
     if (!t) {
         // if there is no next token, we have unexpectedly reached
@@ -21,8 +21,24 @@ bool Parser::peek_equals(Tokenstream& ts, TokenType type) {
 }
 
 ProgramNode Parser::parse(Tokenstream& ts) {
+    arena = &ast.get_arena();
+    pending.clear();
     parse_program(ts);
-    return ast;
+    return std::move(ast);
+}
+
+template <typename T>
+NodeList<T*> Parser::take_list(size_t start) {
+    // moves the children pushed since start into the arena in one piece
+    size_t count = pending.size() - start;
+    T** items = static_cast<T**>(arena->allocate(std::max<size_t>(count, 1) * sizeof(T*), alignof(T*)));
+
+    for (size_t i = 0; i < count; ++i) {
+        items[i] = static_cast<T*>(pending[start + i]);
+    }
+
+    pending.resize(start);
+    return NodeList<T*>(items, count);
 }
 
 void Parser::parse_program(Tokenstream& ts) {
@@ -31,7 +47,7 @@ void Parser::parse_program(Tokenstream& ts) {
     // parse each class in the program in a top-down manner
     // do-while, because at least one class is required
     do {
-        Token* t = ts.get();
+        const Token* t = ts.get();
         if (!t || t->get_type() != TokenType::CLASS) {
             return parser_error(ts, t);
         } else {
@@ -42,21 +58,21 @@ void Parser::parse_program(Tokenstream& ts) {
 }
 
 void Parser::parse_class(Tokenstream& ts) {
-    Token* next = ts.get();
+    const Token* next = ts.get();
 
     if (!next || next->get_type() != TokenType::TYPE_IDENTIFIER) {
         return parser_error(ts, next);
     }
 
-    TypeIdToken* class_name = dynamic_cast<TypeIdToken*>(next);
-    ClassNode* node = new ClassNode(class_name->get_value());
+    const Token* class_name = next;
+    ClassNode* node = arena->make<ClassNode>(ts.get_symbol(class_name));
     node->set_line_number(ts.get_line_number());
 
     // unless otherwise is specified, all classes
     // inherit from Object
-    node->set_base_class(Strings::Types::Object);
+    node->set_base_class(Symbols::Types::Object);
 
-    Token* t = ts.peek();
+    const Token* t = ts.peek();
     if (!t) { parser_error(ts, ts.get()); }
 
     switch (t->get_type()) {
@@ -69,8 +85,8 @@ void Parser::parse_class(Tokenstream& ts) {
                 return parser_error(ts, next);
             }
             
-            TypeIdToken* base_class = dynamic_cast<TypeIdToken*>(next);
-            node->set_base_class(base_class->get_value());
+            const Token* base_class = next;
+            node->set_base_class(ts.get_symbol(base_class));
 
             // intentionally no break - we want to continue
             // to the next case, which is the class body
@@ -110,18 +126,20 @@ void Parser::parse_class(Tokenstream& ts) {
 }
 
 void Parser::parse_features(Tokenstream& ts, ClassNode* cls) {
-    Token* next;
+    const Token* next;
+    size_t start = pending.size();
 
     for (;;) {
         if (!peek_equals(ts, TokenType::OBJ_IDENTIFIER)) {
             // done parsing class features
+            cls->set_features(*arena, take_list<FeatureNode>(start));
             return;
         }
 
-        Token* identifier = ts.get();
-        ObjIdToken* feature_name = dynamic_cast<ObjIdToken*>(identifier);
+        const Token* identifier = ts.get();
+        const Token* feature_name = identifier;
 
-        Token* t = ts.peek();
+        const Token* t = ts.peek();
         if (!t) { parser_error(ts, ts.get()); }
         switch(t->get_type()) {
             case TokenType::COLON: {
@@ -134,9 +152,9 @@ void Parser::parse_features(Tokenstream& ts, ClassNode* cls) {
                 } 
 
                 // built attribute node from identifier and type
-                TypeIdToken* attribute_type = dynamic_cast<TypeIdToken*>(next);
-                AttributeNode* attr_node = new AttributeNode(feature_name->get_value());
-                attr_node->set_type(attribute_type->get_value());
+                const Token* attribute_type = next;
+                AttributeNode* attr_node = arena->make<AttributeNode>(ts.get_symbol(feature_name));
+                attr_node->set_type(ts.get_symbol(attribute_type));
                 attr_node->set_line_number(ts.get_line_number());
 
                 // check if the optional initialization expression is present
@@ -147,7 +165,7 @@ void Parser::parse_features(Tokenstream& ts, ClassNode* cls) {
                     attr_node->set_expr(expr);
                 } else {
                     // no initialization, assign _no_expr instead
-                    ExpressionNode* no_expr = new NoExpressionNode(attr_node->get_type());
+                    ExpressionNode* no_expr = arena->make<NoExpressionNode>(attr_node->get_type());
                     no_expr->set_line_number(ts.get_line_number());
                     attr_node->set_expr(no_expr);
                 }
@@ -158,14 +176,14 @@ void Parser::parse_features(Tokenstream& ts, ClassNode* cls) {
                     return parser_error(ts, next);
                 }
 
-                cls->add_attribute(attr_node);
+                pending.push_back(attr_node);
                 break;
             }
 
             case TokenType::PARENTHESIS_OPEN: {
                 // method feature
                 ts.consume();
-                MethodNode* method_node = new MethodNode(feature_name->get_value());
+                MethodNode* method_node = arena->make<MethodNode>(ts.get_symbol(feature_name));
                 method_node->set_line_number(ts.get_line_number());
 
                 parse_formals(ts, method_node);
@@ -180,9 +198,8 @@ void Parser::parse_features(Tokenstream& ts, ClassNode* cls) {
                     return parser_error(ts, ts.get());
                 }
 
-                Token* type = ts.get();
-                TypeIdToken* type_token = dynamic_cast<TypeIdToken*>(type);
-                method_node->set_type(type_token->get_value());
+                const Token* type = ts.get();
+                method_node->set_type(ts.get_symbol(type));
 
                 next = ts.get();
                 if (!next || next->get_type() != TokenType::CURLY_BRACKET_OPEN) {
@@ -204,7 +221,7 @@ void Parser::parse_features(Tokenstream& ts, ClassNode* cls) {
                     return parser_error(ts, next);
                 }
 
-                cls->add_method(method_node);
+                pending.push_back(method_node);
                 break;
             }
             
@@ -219,23 +236,24 @@ void Parser::parse_features(Tokenstream& ts, ClassNode* cls) {
 
 void Parser::parse_formals(Tokenstream& ts, MethodNode* node) {
     // sets the method parameters of a method node
-    FormalsNode* formals = new FormalsNode();
+    FormalsNode* formals = arena->make<FormalsNode>();
     formals->set_line_number(ts.get_line_number());
+    size_t start = pending.size();
 
     for (;;) {
-        Token* t = ts.peek();
+        const Token* t = ts.peek();
         if (!t) { parser_error(ts, ts.get()); }
 
         switch (t->get_type()) {
             case TokenType::PARENTHESIS_CLOSE:
                 // got closing parenthesis, stop parsing formals
                 ts.consume();
+                formals->set_formals(take_list<FormalNode>(start));
                 return node->set_formals(formals);
             
             case TokenType::OBJ_IDENTIFIER: {
                 // parse another formal
-                Token* name = ts.get();
-                ObjIdToken* name_token = dynamic_cast<ObjIdToken*>(name);
+                const Token* name = ts.get();
                 
                 if (!peek_equals(ts, TokenType::COLON)) {
                     return parser_error(ts, ts.get());
@@ -247,12 +265,11 @@ void Parser::parse_formals(Tokenstream& ts, MethodNode* node) {
                     return parser_error(ts, ts.get());
                 }
 
-                Token* type = ts.get();
-                TypeIdToken* type_token = dynamic_cast<TypeIdToken*>(type);
+                const Token* type = ts.get();
 
-                FormalNode* formal = new FormalNode(name_token->get_value(), type_token->get_value());
+                FormalNode* formal = arena->make<FormalNode>(ts.get_symbol(name), ts.get_symbol(type));
                 formal->set_line_number(ts.get_line_number());
-                formals->add_formal(formal);
+                pending.push_back(formal);
 
                 if (peek_equals(ts, TokenType::COMMA)) {
                     ts.consume();
@@ -278,41 +295,42 @@ void Parser::parse_formals(Tokenstream& ts, MethodNode* node) {
  */ 
 
 ExpressionNode* Parser::parse_expression(Tokenstream& ts) {
-    // we parse expressions by looking a few tokens ahead
     // expressions that start with an expression (e.g. <expr> + <expr>)
-    // are handled in post_expression
-    ExpressionNode* expr = parse_single_expression(ts);
-    return post_expression(ts, expr);
+    // are handled by precedence climbing in parse_operators
+    return parse_operators(ts, Precedence::Lowest);
 }
 
 ExpressionNode* Parser::parse_single_expression(Tokenstream& ts) {
-    ExpressionNode* expr;
-
-    // find a production that matches the current 
-    // position in the token stream
-    if (expr = parse_assignment(ts)) {}
-    else if (expr = parse_dispatch(ts)) {} 
-    else if (expr = parse_conditional(ts)) {} 
-    else if (expr = parse_while(ts)) {}
-    else if (expr = parse_block(ts)) {} 
-    else if (expr = parse_let(ts)) {}
-    else if (expr = parse_case(ts)) {} 
-    else if (expr = parse_new(ts)) {}
-    else if (expr = parse_isvoid(ts)) {}
-    else if (expr = parse_neg(ts)) {}
-    else if (expr = parse_complement(ts)) {}
-    else if (expr = parse_int_const(ts)) {} 
-    else if (expr = parse_string_const(ts)) {} 
-    else if (expr = parse_bool_const(ts)) {} 
-    else if (expr = parse_identifier(ts)) {}
-    else if (expr = parse_parentheses(ts)) {}
-
-    else {
-        // no expression that matches the next token was found
-        parser_error(ts, ts.get());
+    ExpressionNode* expr = nullptr;
+
+    const Token* t = ts.peek();
+    if (!t) { parser_error(ts, ts.get()); }
+
+    // the first token decides which production to parse, each parse
+    // method below starts at that token and consumes it itself
+    switch (t->get_type()) {
+        case TokenType::OBJ_IDENTIFIER: expr = parse_identifier(ts); break;
+        case TokenType::IF: expr = parse_conditional(ts); break;
+        case TokenType::WHILE: expr = parse_while(ts); break;
+        case TokenType::CURLY_BRACKET_OPEN: expr = parse_block(ts); break;
+        case TokenType::LET: expr = parse_let(ts); break;
+        case TokenType::CASE: expr = parse_case(ts); break;
+        case TokenType::NEW: expr = parse_new(ts); break;
+        case TokenType::ISVOID: expr = parse_isvoid(ts); break;
+        case TokenType::SQUIGGLE: expr = parse_neg(ts); break;
+        case TokenType::NOT: expr = parse_complement(ts); break;
+        case TokenType::INTEGER: expr = parse_int_const(ts); break;
+        case TokenType::STRING: expr = parse_string_const(ts); break;
+        case TokenType::BOOL: expr = parse_bool_const(ts); break;
+        case TokenType::PARENTHESIS_OPEN: expr = parse_parentheses(ts); break;
+
+        default:
+            // no expression starts with the next token
+            parser_error(ts, ts.get());
     }
 
-    return expr;
+    // dispatches bind tighter than any operator
+    return parse_dispatches(ts, expr);
 }
 
 
@@ -321,75 +339,64 @@ ExpressionNode* Parser::parse_single_expression(Tokenstream& ts) {
 //
 
 ExpressionNode* Parser::parse_int_const(Tokenstream& ts) {
-    if (peek_equals(ts, TokenType::INTEGER)) {
-        Token* token = ts.get();
-        IntToken* int_token = dynamic_cast<IntToken*>(token);
-        IntNode* int_node = new IntNode(int_token->get_value());
-        int_node->set_line_number(ts.get_line_number());
-        return int_node;
-    }
-    
-    return nullptr;
+    const Token* int_token = ts.get();
+    // like strings, the digits outlive the token stream
+    std::string_view value = ts.get_value(int_token);
+    IntNode* int_node = arena->make<IntNode>(std::string_view(arena->copy(value.data(), value.size()), value.size()));
+    int_node->set_line_number(ts.get_line_number());
+    return int_node;
 }
 
 ExpressionNode* Parser::parse_string_const(Tokenstream& ts) {
-    if (peek_equals(ts, TokenType::STRING)) {
-        Token* token = ts.get();
-        StringToken* string_token = dynamic_cast<StringToken*>(token);
-        StringNode* string_node = new StringNode(string_token->get_value());
-        string_node->set_line_number(ts.get_line_number());
-        return string_node;
-    }
-    
-    return nullptr;
+    const Token* string_token = ts.get();
+    // the string outlives the token stream, so it is copied into the arena
+    std::string_view value = ts.get_value(string_token);
+    StringNode* string_node = arena->make<StringNode>(std::string_view(arena->copy(value.data(), value.size()), value.size()));
+    string_node->set_line_number(ts.get_line_number());
+    return string_node;
 }
 
 ExpressionNode* Parser::parse_bool_const(Tokenstream& ts) {
-    if (peek_equals(ts, TokenType::BOOL)) {
-        Token* token = ts.get();
-        BoolToken* bool_token = dynamic_cast<BoolToken*>(token);
-        BoolNode* bool_node = new BoolNode(bool_token->get_value());
-        bool_node->set_line_number(ts.get_line_number());
-        return bool_node;
-    }
-    
-    return nullptr;
+    const Token* bool_token = ts.get();
+    BoolNode* bool_node = arena->make<BoolNode>(ts.get_bool(bool_token));
+    bool_node->set_line_number(ts.get_line_number());
+    return bool_node;
 }
 
 ExpressionNode* Parser::parse_identifier(Tokenstream& ts) {
-    if (peek_equals(ts, TokenType::OBJ_IDENTIFIER)) {
-        Token* token = ts.get();
-        ObjIdToken* obj_token = dynamic_cast<ObjIdToken*>(token);
-        IdentifierNode* obj_node = new IdentifierNode(obj_token->get_value());
-        obj_node->set_line_number(ts.get_line_number());
-        return obj_node;
+    // 'self' in the dispatch shorthand gets the line of the token before the method name
+    uint self_line_number = ts.get_line_number();
+    const Token* obj_token = ts.get();
+
+    // one token of lookahead tells assignments and dispatches
+    // on self apart from a plain object identifier
+    const Token* next = ts.peek();
+    if (!next) { parser_error(ts, ts.get()); }
+
+    if (next->get_type() == TokenType::ASSIGN) {
+        return parse_assignment(ts, obj_token);
+    } else if (next->get_type() == TokenType::PARENTHESIS_OPEN) {
+        return parse_dispatch(ts, obj_token, self_line_number);
     }
-    
-    return nullptr;
+
+    IdentifierNode* obj_node = arena->make<IdentifierNode>(ts.get_symbol(obj_token));
+    obj_node->set_line_number(ts.get_line_number());
+    return obj_node;
 }
 
 //
 // parse assignments
 //
 
-ExpressionNode* Parser::parse_assignment(Tokenstream& ts) {
-    Token* t1 = ts.get();
-    Token* t2 = ts.get();
-
-    if (!t1) { parser_error(ts, t1); }
-    if (!t2) { parser_error(ts, t2); }
-
-    if (t1->get_type() == TokenType::OBJ_IDENTIFIER && t2->get_type() == TokenType::ASSIGN) {
-        ObjIdToken* name = dynamic_cast<ObjIdToken*>(t1);
-        AssignmentNode* assign_node = new AssignmentNode(name->get_value());
-        assign_node->set_line_number(ts.get_line_number());
-        ExpressionNode* expr = parse_expression(ts);
-        assign_node->set_expr(expr);
-        return assign_node;
-    }
+ExpressionNode* Parser::parse_assignment(Tokenstream& ts, const Token* name) {
+    // consume the assignment operator
+    ts.consume();
 
-    ts.unget(2);
-    return nullptr;
+    AssignmentNode* assign_node = arena->make<AssignmentNode>(ts.get_symbol(name));
+    assign_node->set_line_number(ts.get_line_number());
+    ExpressionNode* expr = parse_expression(ts);
+    assign_node->set_expr(expr);
+    return assign_node;
 }
 
 //
@@ -397,22 +404,18 @@ ExpressionNode* Parser::parse_assignment(Tokenstream& ts) {
 //
 
 ExpressionNode* Parser::parse_new(Tokenstream& ts) {
-    if (peek_equals(ts, TokenType::NEW)) {
-        ts.consume();
-        Token* next = ts.get();
-
-        if (!next || next->get_type() != TokenType::TYPE_IDENTIFIER) {
-            // it is only allowed to call 'new' on type identifiers
-            parser_error(ts, next);
-        }
+    ts.consume();
+    const Token* next = ts.get();
 
-        TypeIdToken* type_token = dynamic_cast<TypeIdToken*>(next);
-        NewNode* new_node = new NewNode(type_token->get_value());
-        new_node->set_line_number(ts.get_line_number());
-        return new_node;
+    if (!next || next->get_type() != TokenType::TYPE_IDENTIFIER) {
+        // it is only allowed to call 'new' on type identifiers
+        parser_error(ts, next);
     }
 
-    return nullptr;
+    const Token* type_token = next;
+    NewNode* new_node = arena->make<NewNode>(ts.get_symbol(type_token));
+    new_node->set_line_number(ts.get_line_number());
+    return new_node;
 }
 
 //
@@ -420,42 +423,30 @@ ExpressionNode* Parser::parse_new(Tokenstream& ts) {
 // 
 
 ExpressionNode* Parser::parse_neg(Tokenstream& ts) {
-    if (peek_equals(ts, TokenType::SQUIGGLE)) {
-        ts.consume();
-        NegNode* neg_node = new NegNode();
-        neg_node->set_line_number(ts.get_line_number());
-        ExpressionNode* expr = parse_single_expression(ts);
-        neg_node->set_expr(expr);
-        return neg_node;
-    }
-    
-    return nullptr;
+    ts.consume();
+    NegNode* neg_node = arena->make<NegNode>();
+    neg_node->set_line_number(ts.get_line_number());
+    ExpressionNode* expr = parse_operators(ts, Precedence::Neg);
+    neg_node->set_expr(expr);
+    return neg_node;
 }
 
 ExpressionNode* Parser::parse_complement(Tokenstream& ts) {
-    if (peek_equals(ts, TokenType::NOT)) {
-        ts.consume();
-        ComplementNode* comp_node = new ComplementNode();
-        comp_node->set_line_number(ts.get_line_number());
-        ExpressionNode* expr = parse_single_expression(ts);
-        comp_node->set_expr(expr);
-        return comp_node;
-    }
-    
-    return nullptr;
+    ts.consume();
+    ComplementNode* comp_node = arena->make<ComplementNode>();
+    comp_node->set_line_number(ts.get_line_number());
+    ExpressionNode* expr = parse_operators(ts, Precedence::Complement);
+    comp_node->set_expr(expr);
+    return comp_node;
 }
 
 ExpressionNode* Parser::parse_isvoid(Tokenstream& ts) {
-    if (peek_equals(ts, TokenType::ISVOID)) {
-        ts.consume();
-        IsvoidNode* isvoid_node = new IsvoidNode();
-        isvoid_node->set_line_number(ts.get_line_number());
-        ExpressionNode* expr = parse_single_expression(ts);
-        isvoid_node->set_expr(expr);
-        return isvoid_node;
-    }
-    
-    return nullptr;
+    ts.consume();
+    IsvoidNode* isvoid_node = arena->make<IsvoidNode>();
+    isvoid_node->set_line_number(ts.get_line_number());
+    ExpressionNode* expr = parse_operators(ts, Precedence::Isvoid);
+    isvoid_node->set_expr(expr);
+    return isvoid_node;
 }
 
 //
@@ -463,137 +454,127 @@ ExpressionNode* Parser::parse_isvoid(Tokenstream& ts) {
 //
 
 ExpressionNode* Parser::parse_conditional(Tokenstream& ts) {
-    Token* next;
+    const Token* next;
 
-    if (peek_equals(ts, TokenType::IF)) {
-        ts.consume();
+    ts.consume();
 
-        ConditionalNode* cond_node = new ConditionalNode();
-        cond_node->set_line_number(ts.get_line_number());
+    ConditionalNode* cond_node = arena->make<ConditionalNode>();
+    cond_node->set_line_number(ts.get_line_number());
 
-        ExpressionNode* predicate = parse_expression(ts);
+    ExpressionNode* predicate = parse_expression(ts);
 
-        next = ts.get();
-        if (!next || next->get_type() != TokenType::THEN) {
-            parser_error(ts, next);
-        }
+    next = ts.get();
+    if (!next || next->get_type() != TokenType::THEN) {
+        parser_error(ts, next);
+    }
 
-        ExpressionNode* then_expr = parse_expression(ts);
+    ExpressionNode* then_expr = parse_expression(ts);
 
-        next = ts.get();
-        if (!next || next->get_type() != TokenType::ELSE) {
-            parser_error(ts, next);
-        }
+    next = ts.get();
+    if (!next || next->get_type() != TokenType::ELSE) {
+        parser_error(ts, next);
+    }
 
-        ExpressionNode* else_expr = parse_expression(ts);
+    ExpressionNode* else_expr = parse_expression(ts);
 
-        next = ts.get();
-        if (!next || next->get_type() != TokenType::FI) {
-            parser_error(ts, next);
-        }
+    next = ts.get();
+    if (!next || next->get_type() != TokenType::FI) {
+        parser_error(ts, next);
+    }
 
-        cond_node->set_predicate(predicate);
-        cond_node->set_then(then_expr);
-        cond_node->set_else(else_expr);
+    cond_node->set_predicate(predicate);
+    cond_node->set_then(then_expr);
+    cond_node->set_else(else_expr);
 
-        return cond_node;
-    }
-    
-    return nullptr;
+    return cond_node;
 }
 
 ExpressionNode* Parser::parse_while(Tokenstream& ts) {
-    Token* next;
+    const Token* next;
 
-    if (peek_equals(ts, TokenType::WHILE)) {
-        ts.consume();
+    ts.consume();
 
-        WhileNode* while_node = new WhileNode();
-        while_node->set_line_number(ts.get_line_number());
+    WhileNode* while_node = arena->make<WhileNode>();
+    while_node->set_line_number(ts.get_line_number());
 
-        ExpressionNode* predicate = parse_expression(ts);
+    ExpressionNode* predicate = parse_expression(ts);
 
-        next = ts.get();
-        if (!next || next->get_type() != TokenType::LOOP) {
-            parser_error(ts, next);
-        }
+    next = ts.get();
+    if (!next || next->get_type() != TokenType::LOOP) {
+        parser_error(ts, next);
+    }
 
-        ExpressionNode* body = parse_expression(ts);
+    ExpressionNode* body = parse_expression(ts);
 
-        next = ts.get();
-        if (!next || next->get_type() != TokenType::POOL) {
-            parser_error(ts, next);
-        }
+    next = ts.get();
+    if (!next || next->get_type() != TokenType::POOL) {
+        parser_error(ts, next);
+    }
 
-        while_node->set_predicate(predicate);
-        while_node->set_body(body);
+    while_node->set_predicate(predicate);
+    while_node->set_body(body);
 
-        return while_node;
-    }
-    
-    return nullptr;
+    return while_node;
 }
 
 ExpressionNode* Parser::parse_case(Tokenstream& ts) {
-    Token* next;
+    const Token* next;
+
+    ts.consume();
 
-    if (peek_equals(ts, TokenType::CASE)) {
-        ts.consume();
+    CaseNode* case_node = arena->make<CaseNode>();
+    case_node->set_line_number(ts.get_line_number());
+    size_t start = pending.size();
 
-        CaseNode* case_node = new CaseNode();
-        case_node->set_line_number(ts.get_line_number());
+    ExpressionNode* expr = parse_expression(ts);
+    case_node->set_target(expr);
 
-        ExpressionNode* expr = parse_expression(ts);
-        case_node->set_target(expr);
+    next = ts.get();
+    if (!next || next->get_type() != TokenType::OF) {
+        parser_error(ts, next);
+    }
 
+    // parse branches
+    // do-while, because at least one branch is required
+    do {           
         next = ts.get();
-        if (!next || next->get_type() != TokenType::OF) {
+        if (!next || next->get_type() != TokenType::OBJ_IDENTIFIER) {
             parser_error(ts, next);
         }
+        const Token* identifier = next;
 
-        // parse branches
-        // do-while, because at least one branch is required
-        do {           
-            next = ts.get();
-            if (!next || next->get_type() != TokenType::OBJ_IDENTIFIER) {
-                parser_error(ts, next);
-            }
-            ObjIdToken* identifier = dynamic_cast<ObjIdToken*>(next);
-
-            next = ts.get();
-            if (!next || next->get_type() != TokenType::COLON) {
-                parser_error(ts, next);
-            }
+        next = ts.get();
+        if (!next || next->get_type() != TokenType::COLON) {
+            parser_error(ts, next);
+        }
 
-            next = ts.get();
-            if (!next || next->get_type() != TokenType::TYPE_IDENTIFIER) {
-                parser_error(ts, next);
-            }
+        next = ts.get();
+        if (!next || next->get_type() != TokenType::TYPE_IDENTIFIER) {
+            parser_error(ts, next);
+        }
 
-            TypeIdToken* type = dynamic_cast<TypeIdToken*>(next);
+        const Token* type = next;
 
-            next = ts.get();
-            if (!next || next->get_type() != TokenType::ARROW) {
-                parser_error(ts, next);
-            }
+        next = ts.get();
+        if (!next || next->get_type() != TokenType::ARROW) {
+            parser_error(ts, next);
+        }
 
-            CaseBranchNode* branch_node = new CaseBranchNode(identifier->get_value(), type->get_value());
-            branch_node->set_line_number(ts.get_line_number());
-            ExpressionNode* expr = parse_expression(ts);
-            branch_node->set_expr(expr);
-            case_node->add_branch(branch_node);
+        CaseBranchNode* branch_node = arena->make<CaseBranchNode>(ts.get_symbol(identifier), ts.get_symbol(type));
+        branch_node->set_line_number(ts.get_line_number());
+        ExpressionNode* expr = parse_expression(ts);
+        branch_node->set_expr(expr);
+        pending.push_back(branch_node);
 
-            next = ts.get();
-            if (!next || next->get_type() != TokenType::SEMICOLON) {
-                parser_error(ts, next);
-            }
-        } while (!peek_equals(ts, TokenType::ESAC));
-        
-        ts.consume();
-        return case_node;
-    }
+        next = ts.get();
+        if (!next || next->get_type() != TokenType::SEMICOLON) {
+            parser_error(ts, next);
+        }
+    } while (!peek_equals(ts, TokenType::ESAC));
     
-    return nullptr;
+    ts.consume();
+    case_node->set_branches(take_list<CaseBranchNode>(start));
+    return case_node;
 }
 
 //
@@ -601,31 +582,29 @@ ExpressionNode* Parser::parse_case(Tokenstream& ts) {
 //
 
 ExpressionNode* Parser::parse_block(Tokenstream& ts) {
-    Token* next;
+    const Token* next;
 
-    if (peek_equals(ts, TokenType::CURLY_BRACKET_OPEN)) {
-        ts.consume();
+    ts.consume();
 
-        BlockNode* block_node = new BlockNode();
-        block_node->set_line_number(ts.get_line_number());
+    BlockNode* block_node = arena->make<BlockNode>();
+    block_node->set_line_number(ts.get_line_number());
+    size_t start = pending.size();
 
-        // do-while, because at least one expression is required
-        do {
-            ExpressionNode* expr = parse_expression(ts);
-            block_node->add_expression(expr);
+    // do-while, because at least one expression is required
+    do {
+        ExpressionNode* expr = parse_expression(ts);
+        pending.push_back(expr);
 
-            // expressions in blocks are terminated by a semicolon
-            next = ts.get();
-            if (!next || next->get_type() != TokenType::SEMICOLON) {
-                parser_error(ts, next);
-            }
-        } while (!peek_equals(ts, TokenType::CURLY_BRACKET_CLOSE));
+        // expressions in blocks are terminated by a semicolon
+        next = ts.get();
+        if (!next || next->get_type() != TokenType::SEMICOLON) {
+            parser_error(ts, next);
+        }
+    } while (!peek_equals(ts, TokenType::CURLY_BRACKET_CLOSE));
 
-        ts.consume();
-        return block_node;
-    }
-    
-    return nullptr;
+    ts.consume();
+    block_node->set_expressions(take_list<ExpressionNode>(start));
+    return block_node;
 }
 
 //
@@ -633,64 +612,63 @@ ExpressionNode* Parser::parse_block(Tokenstream& ts) {
 //
 
 ExpressionNode* Parser::parse_let(Tokenstream& ts) {
-    Token* next;
+    const Token* next;
 
-    if (peek_equals(ts, TokenType::LET)) {
-        ts.consume();
+    ts.consume();
 
-        LetNode* let_node = new LetNode();
-        let_node->set_line_number(ts.get_line_number());
+    LetNode* let_node = arena->make<LetNode>();
+    let_node->set_line_number(ts.get_line_number());
+    size_t start = pending.size();
 
-        // parse let initializers
-        // do-while, because at least one initializer is required
-        do {           
-            next = ts.get();
-            if (!next || next->get_type() != TokenType::OBJ_IDENTIFIER) {
-                parser_error(ts, next);
-            }
-            ObjIdToken* identifier = dynamic_cast<ObjIdToken*>(next);
+    // parse let initializers
+    // do-while, because at least one initializer is required
+    do {           
+        next = ts.get();
+        if (!next || next->get_type() != TokenType::OBJ_IDENTIFIER) {
+            parser_error(ts, next);
+        }
+        const Token* identifier = next;
 
-            next = ts.get();
-            if (!next || next->get_type() != TokenType::COLON) {
-                parser_error(ts, next);
-            }
+        next = ts.get();
+        if (!next || next->get_type() != TokenType::COLON) {
+            parser_error(ts, next);
+        }
 
-            next = ts.get();
-            if (!next || next->get_type() != TokenType::TYPE_IDENTIFIER) {
-                parser_error(ts, next);
-            }
-            TypeIdToken* type = dynamic_cast<TypeIdToken*>(next);
+        next = ts.get();
+        if (!next || next->get_type() != TokenType::TYPE_IDENTIFIER) {
+            parser_error(ts, next);
+        }
+        const Token* type = next;
 
-            LetInitializerNode* init = new LetInitializerNode(identifier->get_value(), type->get_value());
-            init->set_line_number(ts.get_line_number());
+        LetInitializerNode* init = arena->make<LetInitializerNode>(ts.get_symbol(identifier), ts.get_symbol(type));
+        init->set_line_number(ts.get_line_number());
 
-            // check for the optional initialization expressions
-            if (peek_equals(ts, TokenType::ASSIGN)) {
-                ts.consume();
-                ExpressionNode* expr = parse_expression(ts);
-                init->set_expr(expr);
-            } else {
-                ExpressionNode* no_expr = new NoExpressionNode(init->get_type());
-                no_expr->set_line_number(ts.get_line_number());
-                init->set_expr(no_expr);
-            }
+        // check for the optional initialization expressions
+        if (peek_equals(ts, TokenType::ASSIGN)) {
+            ts.consume();
+            ExpressionNode* expr = parse_expression(ts);
+            init->set_expr(expr);
+        } else {
+            ExpressionNode* no_expr = arena->make<NoExpressionNode>(init->get_type());
+            no_expr->set_line_number(ts.get_line_number());
+            init->set_expr(no_expr);
+        }
 
-            let_node->add_initializer(init);
+        pending.push_back(init);
 
-            next = ts.peek();
-            if (!next || next->get_type() != TokenType::IN && next->get_type() != TokenType::COMMA) {
-                parser_error(ts, next);
-            }
-        } while (ts.get()->get_type() != TokenType::IN);
+        next = ts.peek();
+        if (!next || next->get_type() != TokenType::IN && next->get_type() != TokenType::COMMA) {
+            parser_error(ts, next);
+        }
+    } while (ts.get()->get_type() != TokenType::IN);
 
-        // parse let body
-        ExpressionNode* body = parse_expression(ts);
-        let_node->set_body(body);
-        
-        return let_node;
-    }
+    let_node->set_initializers(take_list<LetInitializerNode>(start));
+
+    // parse let body
+    ExpressionNode* body = parse_expression(ts);
+    let_node->set_body(body);
     
-    return nullptr;
+    return let_node;
 }
 
 //
@@ -698,26 +676,16 @@ ExpressionNode* Parser::parse_let(Tokenstream& ts) {
 //
 
 ExpressionNode* Parser::parse_parentheses(Tokenstream& ts) {
-    if (peek_equals(ts, TokenType::PARENTHESIS_OPEN)) {
-        ts.consume();
-
-        ExpressionNode* expr = parse_expression(ts);
+    ts.consume();
 
-        // if the parenthesized expression is an operator (like 2+2), register it
-        // so operator precedence does not affect it
-        if (OperationNode* operator_expr = dynamic_cast<OperationNode*>(expr)) {
-            operator_expr->set_parenthesized();
-        }
+    ExpressionNode* expr = parse_expression(ts);
 
-        Token* next = ts.get();
-        if (!next || next->get_type() != TokenType::PARENTHESIS_CLOSE) {
-            parser_error(ts, next);
-        }
-
-        return expr;
+    const Token* next = ts.get();
+    if (!next || next->get_type() != TokenType::PARENTHESIS_CLOSE) {
+        parser_error(ts, next);
     }
-    
-    return nullptr;
+
+    return expr;
 }
 
 //
@@ -725,12 +693,12 @@ ExpressionNode* Parser::parse_parentheses(Tokenstream& ts) {
 //
 
 // helper method for parsing parameters
-std::vector<ExpressionNode*> Parser::parse_dispatch_parameters(Tokenstream& ts) {
-    std::vector<ExpressionNode*> parameters;
+NodeList<ExpressionNode*> Parser::parse_dispatch_parameters(Tokenstream& ts) {
+    size_t start = pending.size();
 
     while (!peek_equals(ts, TokenType::PARENTHESIS_CLOSE)) {
         ExpressionNode* expr = parse_expression(ts);
-        parameters.push_back(expr);
+        pending.push_back(expr);
 
         if (peek_equals(ts, TokenType::PARENTHESIS_CLOSE)) {
             break;
@@ -752,160 +720,139 @@ std::vector<ExpressionNode*> Parser::parse_dispatch_parameters(Tokenstream& ts)
     // consume the closing parenthesis
     ts.consume();
 
-    return parameters;
+    return take_list<ExpressionNode>(start);
 }
 
-ExpressionNode* Parser::parse_dispatch(Tokenstream& ts) {
+ExpressionNode* Parser::parse_dispatch(Tokenstream& ts, const Token* method_name, uint self_line_number) {
     // this dispatch is shorthand for self.method(params), 
     // so add 'self' as object
-    IdentifierNode* self_obj = new IdentifierNode(Strings::Self);
-    self_obj->set_line_number(ts.get_line_number());
+    IdentifierNode* self_obj = arena->make<IdentifierNode>(Symbols::Self);
+    self_obj->set_line_number(self_line_number);
 
-    Token* t1 = ts.get();
-    Token* t2 = ts.get();
+    // consume the opening parenthesis
+    ts.consume();
 
-    if (!t1) { parser_error(ts, t1); }
-    if (!t2) { parser_error(ts, t2); }
+    DispatchNode* dispatch_node = arena->make<DispatchNode>(self_obj, ts.get_symbol(method_name));
+    dispatch_node->set_line_number(ts.get_line_number());
 
-    if (t1->get_type() == TokenType::OBJ_IDENTIFIER && t2->get_type() == TokenType::PARENTHESIS_OPEN) {
-        ObjIdToken* method_name = dynamic_cast<ObjIdToken*>(t1);
-        DispatchNode* dispatch_node = new DispatchNode(self_obj, method_name->get_value());
-        dispatch_node->set_line_number(ts.get_line_number());
+    dispatch_node->set_parameters(parse_dispatch_parameters(ts));
 
-        for (ExpressionNode* parameter : parse_dispatch_parameters(ts)) {
-            dispatch_node->add_parameter(parameter);
-        }
+    return dispatch_node;
+}
 
-        return dispatch_node;
-    }
+/*
+ *  Operators and dispatches: check if the expression we just parsed
+ *  is only the first part of a larger expression (e.g. <expr> + <expr>)
+ */
 
-    ts.unget(2);
-    return nullptr;
-};
+static BinaryOperator binary_operator(TokenType type) {
+    switch (type) {
+        case TokenType::MULTIPLICATION:
+        case TokenType::DIVISION:
+            return { Precedence::Multiplicative, Associativity::LEFT };
 
-/*
- *  Post-parsing: check if the expression we just parsed is only
- *  the first part of a larger expression (e.g. <expr> + <expr>)
-*/
+        case TokenType::PLUS:
+        case TokenType::MINUS:
+            return { Precedence::Additive, Associativity::LEFT };
+
+        case TokenType::LT:
+        case TokenType::LTE:
+        case TokenType::EQ:
+            return { Precedence::Comparison, Associativity::NONE };
 
-ExpressionNode* Parser::post_expression(Tokenstream& ts, ExpressionNode* expr) {
-    bool continue_flag = true;
-    bool binary_op_flag = false;
+        default:
+            return { 0, Associativity::NONE };
+    }
+}
+
+static BinaryOperationNode* make_binary_operation(Arena& arena, TokenType type) {
+    switch (type) {
+        case TokenType::PLUS: return arena.make<PlusNode>();
+        case TokenType::MINUS: return arena.make<MinusNode>();
+        case TokenType::MULTIPLICATION: return arena.make<MultiplicationNode>();
+        case TokenType::DIVISION: return arena.make<DivisionNode>();
+        case TokenType::LT: return arena.make<LTNode>();
+        case TokenType::LTE: return arena.make<LTENode>();
+        default: return arena.make<EQNode>();
+    }
+}
+
+ExpressionNode* Parser::parse_operators(Tokenstream& ts, uint max_precedence) {
+    // precedence climbing: parse an expression in which every binary
+    // operator binds at least as tightly as max_precedence,
+    // each level of nesting in the program passes through here
+    ExpressionNode* expr = StackSegments::nested([&] { return parse_single_expression(ts); });
+    uint previous_precedence = 0;
 
-    while (continue_flag) {
-        Token* t = ts.peek();
+    for (;;) {
+        const Token* t = ts.peek();
         if (!t) { parser_error(ts, ts.get()); }
-    
-        OperationNode* prev_operator = dynamic_cast<OperationNode*>(expr);
-        OperationNode* right_most_operation = prev_operator;
-        BinaryOperationNode* node;
-
-        // check if the previous expression is an operator
-        if (prev_operator) {
-            // if so, find the right-most operation in the tree
-            for (;;) {
-                ExpressionNode* expr = right_most_operation->get_last();
-                if (OperationNode* nested_binary_operator = dynamic_cast<OperationNode*>(expr)) {
-                    OperationNode* new_right_most_operation = nested_binary_operator;
-                    new_right_most_operation->set_parent(right_most_operation);
-                    right_most_operation = new_right_most_operation;
-                } else {
-                    break;
-                }
-            }
-        }
 
-        switch (t->get_type()) {
-            // binary operators
-            case TokenType::PLUS:
-                node = new PlusNode();
-                binary_op_flag = true;
-                break;
+        BinaryOperator op = binary_operator(t->get_type());
+        if (op.precedence == 0 || op.precedence > max_precedence) {
+            return expr;
+        }
 
-            case TokenType::MINUS:
-                node = new MinusNode();
-                binary_op_flag = true;
-                break;
+        const Token* op_token = ts.get();
+        BinaryOperationNode* node = make_binary_operation(*arena, op_token->get_type());
+        node->set_line_number(ts.get_line_number());
 
-            case TokenType::MULTIPLICATION:
-                node = new MultiplicationNode();
-                binary_op_flag = true;
-                break;
-            
-            case TokenType::DIVISION:
-                node = new DivisionNode();
-                binary_op_flag = true;
-                break;
+        // non-associative operators cannot be chained (e.g. a = b = c)
+        if (op.associativity == Associativity::NONE && previous_precedence == op.precedence) {
+            parser_error(ts, op_token);
+        }
 
-            case TokenType::LT:
-                node = new LTNode();
-                binary_op_flag = true;
-                break;
+        // the right operand only contains operators that bind tighter,
+        // which makes the operators left-associative
+        ExpressionNode* right = parse_operators(ts, op.precedence - 1);
 
-            case TokenType::LTE:
-                node = new LTENode();
-                binary_op_flag = true;
-                break;
+        node->set_first(expr);
+        node->set_second(right);
+        expr = node;
+        previous_precedence = op.precedence;
+    }
+}
 
-            case TokenType::EQ:
-                node = new EQNode();
-                binary_op_flag = true;
-                break;                
+ExpressionNode* Parser::parse_dispatches(Tokenstream& ts, ExpressionNode* expr) {
+    for (;;) {
+        const Token* t = ts.peek();
+        if (!t) { parser_error(ts, ts.get()); }
 
+        switch (t->get_type()) {
             // dispatch
             case TokenType::DOT: {
                 ts.consume();
-                Token* next = ts.get();
+                const Token* next = ts.get();
 
                 if (!next || next->get_type() != TokenType::OBJ_IDENTIFIER) {
                     parser_error(ts, next);
                 }
 
-                ObjIdToken* identifier = dynamic_cast<ObjIdToken*>(next);
+                const Token* identifier = next;
 
                 next = ts.get();
                 if (!next || next->get_type() != TokenType::PARENTHESIS_OPEN) {
                     parser_error(ts, next);
                 }
 
-                if (prev_operator && !prev_operator->is_parenthesized()) {
-                    // we have an expression like `a + b.dispatch`
-                    // dispatches always bind tighter than operators, replace the existing right-most expression
-                    // with a dispatch to that expression
-                    DispatchNode* dispatch_node = new DispatchNode(right_most_operation->get_last(), identifier->get_value());
-                    dispatch_node->set_line_number(ts.get_line_number());
-                    
-                    for (ExpressionNode* e : parse_dispatch_parameters(ts)) {
-                        dispatch_node->add_parameter(e);
-                    }
-
-                    right_most_operation->set_last(dispatch_node);
-                } 
-                
-                else {
-                    // just a normal dispatch, replace the expression with a dispatch to that expression 
-                    DispatchNode* dispatch_node = new DispatchNode(expr, identifier->get_value());
-                    dispatch_node->set_line_number(ts.get_line_number());
-    
-                    for (ExpressionNode* e : parse_dispatch_parameters(ts)) {
-                        dispatch_node->add_parameter(e);
-                    }
+                DispatchNode* dispatch_node = arena->make<DispatchNode>(expr, ts.get_symbol(identifier));
+                dispatch_node->set_line_number(ts.get_line_number());
 
-                    expr = dispatch_node;
-                }
-                
+                dispatch_node->set_parameters(parse_dispatch_parameters(ts));
+
+                expr = dispatch_node;
                 break;
             }
-        
+
             // static dispatch
             case TokenType::AT: {
                 ts.consume();
-                Token* next = ts.get();
+                const Token* next = ts.get();
                 if (!next || next->get_type() != TokenType::TYPE_IDENTIFIER) {
                     parser_error(ts, next);
                 }
 
-                TypeIdToken* static_type = dynamic_cast<TypeIdToken*>(next);
+                const Token* static_type = next;
 
                 next = ts.get();
                 if (!next || next->get_type() != TokenType::DOT) {
@@ -917,111 +864,25 @@ ExpressionNode* Parser::post_expression(Tokenstream& ts, ExpressionNode* expr) {
                     parser_error(ts, next);
                 }
 
-                ObjIdToken* identifier = dynamic_cast<ObjIdToken*>(next);
+                const Token* identifier = next;
 
                 next = ts.get();
                 if (!next || next->get_type() != TokenType::PARENTHESIS_OPEN) {
                     parser_error(ts, next);
                 }
 
-                if (prev_operator && !prev_operator->is_parenthesized()) {
-                    // we have an expression like `a + b.dispatch`
-                    // dispatches always bind tighter than operators, replace the existing right-most expression
-                    // with a dispatch to that expression
-                    StaticDispatchNode* dispatch_node = new StaticDispatchNode(right_most_operation->get_last(), identifier->get_value());
-                    dispatch_node->set_static_type(static_type->get_value());
-                    dispatch_node->set_line_number(ts.get_line_number());
-                    
-                    for (ExpressionNode* e : parse_dispatch_parameters(ts)) {
-                        dispatch_node->add_parameter(e);
-                    }
-
-                    right_most_operation->set_last(dispatch_node);
-                } 
-                
-                else {
-                    // just a normal dispatch, replace the expression with a dispatch to that expression 
-                    StaticDispatchNode* dispatch_node = new StaticDispatchNode(expr, identifier->get_value());
-                    dispatch_node->set_static_type(static_type->get_value());
-                    dispatch_node->set_line_number(ts.get_line_number());
+                StaticDispatchNode* dispatch_node = arena->make<StaticDispatchNode>(expr, ts.get_symbol(identifier));
+                dispatch_node->set_static_type(ts.get_symbol(static_type));
+                dispatch_node->set_line_number(ts.get_line_number());
 
-                    for (ExpressionNode* e : parse_dispatch_parameters(ts)) {
-                        dispatch_node->add_parameter(e);
-                    }
-
-                    expr = dispatch_node;
-                }
+                dispatch_node->set_parameters(parse_dispatch_parameters(ts));
 
+                expr = dispatch_node;
                 break;
             }
 
             default:
-                continue_flag = false;
-                break;
+                return expr;
         }
-
-        if (binary_op_flag) {
-            // the expression is a binary operation
-            Token* t = ts.get();
-            node->set_line_number(ts.get_line_number());
-            ExpressionNode* next_expr = parse_single_expression(ts);
-            
-            // first, check if we're associating non-associative operations (e.g. a == b == c)
-            if (BinaryOperationNode* prev_binary_expr = dynamic_cast<BinaryOperationNode*>(expr)) {
-                if (prev_binary_expr->get_associativity() == Associativity::NONE
-                    && node->get_associativity() == Associativity::NONE) {
-                        parser_error(ts, t);
-                    }
-            }
-
-            if (prev_operator && !prev_operator->is_parenthesized()) {
-                // find the correct position in the expression tree to insert next expression
-                OperationNode* operation_in_tree = right_most_operation;
-
-                for (;;) {
-                    if (node->get_precedence() < operation_in_tree->get_precedence()) {
-                        // if this operator has higher precedence this one in the tree
-                        node->set_first(operation_in_tree->get_last());
-                        node->set_second(next_expr);
-                        operation_in_tree->set_last(node);
-                        break;
-                    } 
-                    
-                    else {
-                        // if this operator has lower or equal precedence than the previous
-                        // note: we make the previous expression the first child of the new node
-                        // in order to enforce left-associativity
-                        
-                        if (!operation_in_tree->get_parent()) {
-                            node->set_first(expr);
-                            node->set_second(next_expr);
-                            expr = node;
-                            break;
-                        } else {
-                            operation_in_tree = operation_in_tree->get_parent();
-                        }    
-                    }
-                }
-            }
-
-            else if (dynamic_cast<DispatchNode*>(expr)) {
-                // if previous expression is a dispatch
-                // example: a.dispatch() + b
-                node->set_first(expr);
-                node->set_second(next_expr);
-                expr = node;
-            } 
-            
-            else {
-                // if it's just an expression (like 123 or abc)
-                node->set_first(expr);
-                node->set_second(next_expr);
-                expr = node;
-            }
-        }
-
-        binary_op_flag = false;
     }
-
-    return expr;
 }
\ No newline at end of file
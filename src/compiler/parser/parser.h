@@ -7,10 +7,41 @@
 #include "../../common/consts.h"
 #include "../../utils/errors.h"
 
+// operator precedence as listed in README.md, lower values bind tighter
+namespace Precedence {
+    constexpr uint Neg = 2;
+    constexpr uint Isvoid = 3;
+    constexpr uint Multiplicative = 4;
+    constexpr uint Additive = 5;
+    constexpr uint Comparison = 6;
+    constexpr uint Complement = 7;
+    constexpr uint Lowest = 7;
+}
+
+enum Associativity {
+    LEFT,
+    NONE
+};
+
+struct BinaryOperator {
+    uint precedence;    // 0 if the token is not a binary operator
+    Associativity associativity;
+};
+
 class Parser {
     private:
         ProgramNode ast;
 
+        // every node is allocated in the arena owned by the program
+        Arena* arena = nullptr;
+
+        // children of the lists being parsed; the children of a nested
+        // list are pushed on top and taken off before the outer list goes on
+        std::vector<Node*> pending;
+
+        template <typename T>
+        NodeList<T*> take_list(size_t);
+
         void parse_program(Tokenstream&);
         void parse_class(Tokenstream&);
         void parse_features(Tokenstream&, ClassNode*);
@@ -21,7 +52,7 @@ class Parser {
         ExpressionNode* parse_string_const(Tokenstream&);
         ExpressionNode* parse_bool_const(Tokenstream&);
         ExpressionNode* parse_identifier(Tokenstream&);
-        ExpressionNode* parse_assignment(Tokenstream&);
+        ExpressionNode* parse_assignment(Tokenstream&, const Token*);
         ExpressionNode* parse_new(Tokenstream&);
         ExpressionNode* parse_isvoid(Tokenstream&);
         ExpressionNode* parse_neg(Tokenstream&);
@@ -32,11 +63,12 @@ class Parser {
         ExpressionNode* parse_let(Tokenstream&);
         ExpressionNode* parse_case(Tokenstream&);
         ExpressionNode* parse_parentheses(Tokenstream&);
-        ExpressionNode* parse_dispatch(Tokenstream&);
+        ExpressionNode* parse_dispatch(Tokenstream&, const Token*, uint);
         
         ExpressionNode* parse_single_expression(Tokenstream&);
-        ExpressionNode* post_expression(Tokenstream&, ExpressionNode*);    
-        std::vector<ExpressionNode*> parse_dispatch_parameters(Tokenstream&);
+        ExpressionNode* parse_operators(Tokenstream&, uint);
+        ExpressionNode* parse_dispatches(Tokenstream&, ExpressionNode*);
+        NodeList<ExpressionNode*> parse_dispatch_parameters(Tokenstream&);
 
         bool peek_equals(Tokenstream&, TokenType);
 
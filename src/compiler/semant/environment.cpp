@@ -4,63 +4,40 @@
  *  Implementation of the type environment methods.
  */
 
-void ObjectScope::add_object(const std::string& name, const std::string& type) {
-    // add object to the scope
-    objects[name] = type;
-}
-
-bool ObjectScope::exists(const std::string& name) {
-    // check if object exists in the scope
-    return objects.find(name) != objects.end();
-}
-
-std::string ObjectScope::get_object(const std::string& name) {
-    // get the type of the object
-    if (exists(name)) {
-        return objects.find(name)->second;
-    } else {
-        return "";
-    }
-}
-
 void ObjectEnv::enter_scope() {
-    scopes.push_back(new ObjectScope());
+    objects.enter_scope();
 }
 
 void ObjectEnv::exit_scope() {
-    scopes.pop_back();
+    objects.exit_scope();
 }
 
-void ObjectEnv::add_object(const std::string& name, const std::string& type) {
+void ObjectEnv::add_object(Symbol name, Symbol type) {
     // add object to the current scope
-    scopes.back()->add_object(name, type);
+    objects.add(name, type);
 }
 
-bool ObjectEnv::probe(const std::string& name) {
+bool ObjectEnv::probe(Symbol name) {
     // check if object is defined in current scope
-    return scopes.back()->exists(name);
+    return objects.probe(name);
 }
 
-std::string ObjectEnv::lookup(const std::string& name) {
+Symbol ObjectEnv::lookup(Symbol name) {
     // return the closest definition of the object
-    for (auto it = scopes.rbegin(); it != scopes.rend(); ++it) {
-        ObjectScope* scope = *it;
-        if (scope->exists(name)) {
-            return scope->get_object(name);
-        }
-    }
-
-    return "";
+    const Symbol* type = objects.lookup(name);
+    return type ? *type : Symbols::Empty;
 }
 
-MethodNode* MethodEnv::find(const std::string& cls, const std::string& method) {
-    return methods[std::make_pair(cls, method)];
+MethodNode* MethodEnv::find(Symbol cls, Symbol method) {
+    // never inserts, as several threads look up methods at once
+    auto it = methods.find(key(cls, method));
+    return it != methods.end() ? it->second : nullptr;
 }
 
-void MethodEnv::set(const std::string& cls, MethodNode* method) {
-    methods[std::make_pair(cls, method->get_name())] = method;
+void MethodEnv::set(Symbol cls, MethodNode* method) {
+    methods[key(cls, method->get_name())] = method;
 }
 
-bool MethodEnv::exists(const std::string& cls, const std::string& method) {
-    return methods.find(std::make_pair(cls, method)) != methods.end();
+bool MethodEnv::exists(Symbol cls, Symbol method) {
+    return methods.find(key(cls, method)) != methods.end();
 }
\ No newline at end of file
@@ -3,47 +3,50 @@
 
 #include <string>
 #include <map>
+#include <unordered_map>
+#include <cstdint>
 #include "../../common/ast.h"
+#include "../../common/symbol.h"
+#include "../../common/scoped_table.h"
 
-class ObjectScope {
-    private:
-        std::map<std::string, std::string> objects;
-
-    public:
-        std::map<std::string, std::string> get_objects();
-        void add_object(const std::string&, const std::string&);
-        bool exists(const std::string&);
-        std::string get_object(const std::string&);
-};
-
+// the types of the objects in scope, keyed by their names
 class ObjectEnv {
     private:
-        std::vector<ObjectScope*> scopes;
-    
+        ScopedTable<Symbol> objects;
+
     public:
         void enter_scope();
         void exit_scope();
-        void add_object(const std::string&, const std::string&);
-        bool probe(const std::string&);
-        std::string lookup(const std::string&);
+        void add_object(Symbol, Symbol);
+        bool probe(Symbol);
+        Symbol lookup(Symbol);
 };
 
 class MethodEnv {
     private:
         // map a class name and method name pair to a MethodNode
-        std::map<std::pair<std::string, std::string>, MethodNode*> methods;
+        // the two symbol IDs are packed into a single key
+        std::unordered_map<uint64_t, MethodNode*> methods;
+
+        static uint64_t key(Symbol cls, Symbol method) {
+            return (uint64_t(cls.get_id()) << 32) | method.get_id();
+        }
 
     public:
-        MethodNode* find(const std::string& cls, const std::string&);
-        void set(const std::string&, MethodNode*);
-        bool exists(const std::string& cls, const std::string&);
+        MethodNode* find(Symbol cls, Symbol);
+        void set(Symbol, MethodNode*);
+        bool exists(Symbol cls, Symbol);
 };
 
+// the method environment is built once and shared by the
+// environments of all threads checking classes
 class TypeEnvironment {
     public:
         ObjectEnv objects;
-        MethodEnv methods;
-        ClassNode* cls;
+        MethodEnv& methods;
+        ClassNode* cls = nullptr;
+
+        TypeEnvironment(MethodEnv& m) : methods(m) {}
 };
 
 #endif
\ No newline at end of file
@@ -5,10 +5,13 @@
 #include <vector>
 #include <unordered_set>
 #include <algorithm>
+#include <memory>
 #include "environment.h"
 #include "../../common/ast.h"
 #include "../../common/classtable.h"
 #include "../../common/consts.h"
 #include "../../utils/errors.h"
+#include "../../utils/parallel.h"
+#include "../../utils/phase_timer.h"
 
 #endif
\ No newline at end of file
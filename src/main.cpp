@@ -1,35 +1,184 @@
 #include <iostream>
-#include <sstream>
-#include <fstream>
 #include <stdexcept>
 #include "utils/cmdline_options.h"
+#include "utils/source_file.h"
+#include "utils/stack_segments.h"
+#include "utils/parallel.h"
+#include "utils/errors.h"
+#include "utils/phase_timer.h"
 #include "common/classtable.h"
+#include "common/ast_cache.h"
+#include "common/ast_stats.h"
+#include "common/compiler_stats.h"
+#include "common/ast_json.h"
 #include "compiler/lexer/lexer.h"
 #include "compiler/parser/parser.h"
 #include "compiler/semant/semant.h"
 #include "compiler/codegen/codegen.h"
 
-void compile(std::stringstream& program, CmdlineOptions* options) {
+// token dump for --lex
+void dump(Tokenstream& ts, CmdlineOptions* options) {
+    PhaseTimer timer(Phase::Output);
+    while (const Token* token = ts.get()) {
+        if (options->get_json()) {
+            ts.dump_json(*token);
+        } else {
+            ts.dump(*token);
+        }
+    }
+    Writer::standard_output().flush();
+}
+
+// syntax tree dump for --parse and --semant
+void dump(ProgramNode& ast, CmdlineOptions* options) {
+    PhaseTimer timer(Phase::Output);
+    if (options->get_json()) {
+        AstJson(Writer::standard_output()).write(ast);
+    } else {
+        ast.dump(0);
+    }
+    Writer::standard_output().flush();
+}
+
+// front end for a single file, returns false if compilation stops after lexing
+bool parse(SourceFile& program, CmdlineOptions* options, AstCache* cache, ProgramNode& ast, bool& annotated) {
+    // the token dump always comes from the lexer, everything
+    // after it can start from a cached AST
+    if (cache && options->get_stop_after() != StopAfter::LEX) {
+        bool keep_annotations = options->get_stop_after() != StopAfter::PARSE;
+        PhaseTimer timer(Phase::Parse);
+        if (cache->load(program.get_contents(), ast, keep_annotations, annotated)) {
+            return true;
+        }
+    }
+
     Scanner scanner;
     Parser parser;
 
-    Tokenstream ts = scanner.scan(program);
+    auto scan = [&] {
+        PhaseTimer timer(Phase::Scan);
+        return scanner.scan(program.get_contents(), options->get_jobs());
+    };
+
+    // when streaming, the lexer only runs ahead of the parser by a
+    // bounded window of tokens instead of scanning the whole program first
+    Tokenstream ts = options->get_streaming() ? Tokenstream(Tokenstream::DefaultWindow) : scan();
+    if (options->get_streaming()) {
+        scanner.reset(program.get_contents(), ts);
+        ts.stream([&scanner] { return scanner.step(); }, options->get_lex_thread());
+    }
+
+    if (options->get_stop_after() == StopAfter::LEX) {
+        dump(ts, options);
+        CompilerStats::tokens.add(ts.size() * sizeof(Token), ts.size());
+        return false;
+    }
+
+    {
+        PhaseTimer timer(Phase::Parse);
+        ast = parser.parse(ts);
+    }
+    CompilerStats::tokens.add(ts.size() * sizeof(Token), ts.size());
+
+    if (cache) {
+        PhaseTimer timer(Phase::Output);
+        cache->store(program.get_contents(), ast, false);
+    }
+
+    return true;
+}
+
+// front end for several files, which are lexed and parsed in parallel
+// and merged into one program in the order they were given
+bool parse(std::vector<std::unique_ptr<SourceFile>>& programs, CmdlineOptions* options, ProgramNode& ast) {
+    size_t count = programs.size();
+    std::vector<Tokenstream> streams(count);
+
+    // identifiers are numbered per file while lexing and interned one
+    // file after another, so symbol IDs do not depend on the scheduling
+    {
+        PhaseTimer timer(Phase::Scan);
+        parallel_for(count, options->get_jobs(), [&](size_t i) {
+            Scanner scanner;
+            streams[i].use_local_symbols();
+            scanner.reset(programs[i]->get_contents(), streams[i]);
+            while (scanner.step()) {}
+        });
+
+        for (Tokenstream& ts : streams) {
+            ts.intern_local_symbols();
+            CompilerStats::tokens.add(ts.size() * sizeof(Token), ts.size());
+        }
+    }
+
     if (options->get_stop_after() == StopAfter::LEX) {
-        for (auto token : ts.get_tokens()) {
-            token->dump();
+        for (size_t i = 0; i < count; ++i) {
+            streams[i].relocate(0);
+            if (options->get_json()) {
+                Writer::standard_output() << "{\"file\":" << get_json_string(programs[i]->get_name()) << "}\n";
+            } else {
+                Writer::standard_output() << "#name \"" << programs[i]->get_name() << "\"\n";
+            }
+            dump(streams[i], options);
         }
-        return;
+        return false;
+    }
+
+    // the lines of each file are numbered after those of the previous files
+    std::vector<uint> line_offsets;
+    for (std::unique_ptr<SourceFile>& program : programs) {
+        line_offsets.push_back(SourceMap::add_file(*program));
+    }
+
+    PhaseTimer timer(Phase::Parse);
+    std::vector<ProgramNode> parsed(count);
+    std::vector<std::unique_ptr<ParseError>> errors(count);
+
+    parallel_for(count, options->get_jobs(), [&](size_t i) {
+        Parser parser;
+        streams[i].relocate(line_offsets[i]);
+
+        try {
+            parsed[i] = parser.parse(streams[i]);
+        } catch (const ParseError& error) {
+            errors[i] = std::make_unique<ParseError>(error);
+        }
+    });
+
+    // only the error of the first file is reported, as if the files were parsed in order
+    for (size_t i = 0; i < count; ++i) {
+        if (errors[i]) {
+            throw *errors[i];
+        }
+        ast.merge(parsed[i]);
     }
 
-    ProgramNode ast = parser.parse(ts);
+    ast.set_line_number(parsed.back().get_line_number());
+    return true;
+}
+
+void compile(ProgramNode& ast, bool annotated, CmdlineOptions* options, AstCache* cache, SourceFile* program) {
     if (options->get_stop_after() == StopAfter::PARSE) {
-        ast.dump(0);
+        dump(ast, options);
         return;
     }
 
-    ClassTable* classtable = ast.analyze();
+    // a program is only cached with its types after it passed the analysis,
+    // in which case the class table is all that is left to build
+    ClassTable* classtable;
+    if (annotated) {
+        PhaseTimer timer(Phase::ClassTable);
+        classtable = new ClassTable(ast.get_classes(), ast.get_arena());
+    } else {
+        classtable = ast.analyze(options->get_jobs());
+        if (cache && program) {
+            PhaseTimer timer(Phase::Output);
+            cache->store(program->get_contents(), ast, true);
+        }
+    }
+
     if (options->get_stop_after() == StopAfter::SEMANT) {
-        ast.dump(0);
+        dump(ast, options);
         return;
     }
 
@@ -38,17 +187,62 @@ void compile(std::stringstream& program, CmdlineOptions* options) {
 
 int main(int argc, char *argv[]) {
     CmdlineOptions* options = new CmdlineOptions(argc, argv);
-    
-    std::stringstream buffer;
-    std::ifstream t_file(options->get_sourcefile_name());
+    StackSegments::set_segment_depth(options->get_stack_depth());
 
-    if (!t_file) {
-        throw std::runtime_error("Invalid file.");
+    // the sources are memory-mapped rather than copied,
+    // tokens refer directly into them
+    std::vector<std::unique_ptr<SourceFile>> programs;
+    {
+        PhaseTimer timer(Phase::Read);
+        for (const std::string& name : options->get_sourcefile_names()) {
+            programs.push_back(std::make_unique<SourceFile>(name));
+        }
+    }
+
+    // the cache holds single files, a program made of several files is always parsed
+    std::unique_ptr<AstCache> cache;
+    if (options->get_cache() && programs.size() == 1) {
+        std::string directory = options->get_cache_dir();
+        cache = std::make_unique<AstCache>(directory.empty() ? AstCache::default_directory() : directory);
     }
 
-    buffer << t_file.rdbuf();
+    ProgramNode ast;
+    bool annotated = false;
+    bool parsed = false;
+
+    try {
+        parsed = programs.size() == 1 ? parse(*programs[0], options, cache.get(), ast, annotated)
+                                      : parse(programs, options, ast);
+    } catch (const ParseError& error) {
+        report_parse_error(error);
+    }
 
-    compile(buffer, options);
+    // the tree is measured as the parser built it, before the analysis adds to the arena
+    std::unique_ptr<AstStats> ast_stats;
+    if (parsed && options->get_stats()) {
+        ast_stats = std::make_unique<AstStats>(ast);
+    }
+
+    if (parsed) {
+        try {
+            compile(ast, annotated, options, cache.get(), programs.size() == 1 ? programs[0].get() : nullptr);
+        } catch (const SemantError& error) {
+            report_semant_error(error);
+        }
+    }
+
+    if (cache && options->get_cache_stats()) {
+        cache->print_stats();
+    }
+
+    // reports for tools go to standard error, one JSON object per line
+    Writer report(STDERR_FILENO);
+    if (options->get_time_phases()) {
+        PhaseTimer::write_json(report);
+    }
+    if (options->get_stats()) {
+        CompilerStats::write_json(report, ast_stats.get());
+    }
 
     return 0;
-}
\ No newline at end of file
+}
@@ -5,13 +5,24 @@
  */
 
 void CmdlineOptions::print_usage(int exit_code = 0) {
-    std::cerr << "Usage: ./coolr <sourcefile> [options]\n";
+    std::cerr << "Usage: ./coolr <sourcefile>... [options]\n";
     std::cerr << "Options:\n";
     std::cerr << "  --help\t\t\tPrint this help message\n";
     std::cerr << "  --out <file>\t\t\tSpecify the output file (default: out.S)\n";
     std::cerr << "  --lex\t\t\t\tStop after lexical analysis\n";
     std::cerr << "  --parse\t\t\tStop after parsing\n";
     std::cerr << "  --semant\t\t\tStop after semantic analysis\n";
+    std::cerr << "  --json\t\t\tDump tokens and syntax trees as JSON lines\n";
+    std::cerr << "  --stream\t\t\tLex on demand while parsing\n";
+    std::cerr << "  --lex-thread\t\t\tLex in a separate thread while parsing\n";
+    std::cerr << "  --jobs <n>\t\t\tNumber of threads to use (default: number of cores)\n";
+    std::cerr << "  --stack-depth <n>\t\tLevels of nesting before moving to a new stack (default: 5000)\n";
+    std::cerr << "  --cache\t\t\tReuse the parsed and analyzed AST of an unchanged source\n";
+    std::cerr << "  --cache-dir <dir>\t\tCache ASTs in this directory (default with --cache: ~/.cache/coolr)\n";
+    std::cerr << "  --no-cache\t\t\tAlways lex and parse the source, even with --cache or --cache-dir\n";
+    std::cerr << "  --cache-stats\t\t\tPrint the AST cache hits and misses\n";
+    std::cerr << "  --stats\t\t\tPrint the number and size of tokens, AST nodes and generated code as JSON\n";
+    std::cerr << "  --time-phases\t\t\tPrint the wall and CPU time of each compiler phase as JSON\n";
     exit(exit_code);
 }
 
@@ -20,8 +31,6 @@ CmdlineOptions::CmdlineOptions(int argc, char *argv[]) {
         print_usage(1);
     }
 
-    sourcefile = std::string(argv[1]);
-
     for (int i = 1; i < argc; ++i) {
         std::string arg = std::string(argv[i]);
         if (arg == "--help") {
@@ -32,12 +41,60 @@ CmdlineOptions::CmdlineOptions(int argc, char *argv[]) {
             stop_after = StopAfter::PARSE;
         } else if (arg == "--semant") {
             stop_after = StopAfter::SEMANT;
+        } else if (arg == "--json") {
+            json = true;
+        } else if (arg == "--stream") {
+            streaming = true;
+        } else if (arg == "--lex-thread") {
+            streaming = true;
+            lex_thread = true;
+        } else if (arg == "--jobs") {
+            if (argc > i + 1) {
+                jobs = std::max(1, std::stoi(argv[++i]));
+            } else {
+                throw std::runtime_error("Number of jobs not specified after --jobs.");
+            }
+        } else if (arg == "--stack-depth") {
+            if (argc > i + 1) {
+                stack_depth = std::max(1, std::stoi(argv[++i]));
+            } else {
+                throw std::runtime_error("Depth not specified after --stack-depth.");
+            }
+        } else if (arg == "--cache") {
+            cache = true;
+        } else if (arg == "--no-cache") {
+            no_cache = true;
+        } else if (arg == "--cache-dir") {
+            if (argc > i + 1) {
+                cache = true;
+                cache_dir = std::string(argv[++i]);
+            } else {
+                throw std::runtime_error("Cache directory not specified after --cache-dir.");
+            }
+        } else if (arg == "--cache-stats") {
+            cache_stats = true;
+        } else if (arg == "--stats") {
+            stats = true;
+        } else if (arg == "--time-phases") {
+            time_phases = true;
         } else if (arg == "--out") { 
             if (argc > i + 1) {
                 outfile = std::string(argv[++i]); 
             } else {
                 throw std::runtime_error("Output file name not specified after --out.");
             }
+        } else if (arg.rfind("--", 0) != 0) {
+            // the classes of all source files make up one program
+            sourcefiles.push_back(arg);
         }
     }
+
+    if (sourcefiles.empty()) {
+        print_usage(1);
+    }
+
+    // --no-cache wins over --cache and --cache-dir, wherever it is given
+    if (no_cache) {
+        cache = false;
+    }
 };
\ No newline at end of file
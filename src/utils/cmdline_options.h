@@ -2,8 +2,12 @@
 #define CMDLINE_OPTIONS_H
 
 #include <string>
+#include <vector>
 #include <stdexcept>
 #include <iostream>
+#include <thread>
+#include <algorithm>
+#include "../common/consts.h"
 
 enum StopAfter {
     LEX,
@@ -14,15 +18,26 @@ enum StopAfter {
 
 class CmdlineOptions {
     private:
-        std::string sourcefile;
+        std::vector<std::string> sourcefiles;
         std::string outfile = "out.S";
         StopAfter stop_after = StopAfter::CODEGEN;
+        bool streaming = false;
+        bool lex_thread = false;
+        uint jobs = std::max(1u, std::thread::hardware_concurrency());
+        uint stack_depth = Constants::StackSegmentDepth;
+        bool cache = false;
+        bool no_cache = false;
+        std::string cache_dir;
+        bool cache_stats = false;
+        bool stats = false;
+        bool time_phases = false;
+        bool json = false;
 
     public:
         CmdlineOptions(int ac, char *av[]);
 
-        std::string get_sourcefile_name() {
-            return sourcefile;
+        std::vector<std::string> get_sourcefile_names() {
+            return sourcefiles;
         }
 
         std::string get_outfile_name() {
@@ -33,6 +48,46 @@ class CmdlineOptions {
             return stop_after;
         }
 
+        bool get_streaming() {
+            return streaming;
+        }
+
+        bool get_lex_thread() {
+            return lex_thread;
+        }
+
+        uint get_jobs() {
+            return jobs;
+        }
+
+        uint get_stack_depth() {
+            return stack_depth;
+        }
+
+        bool get_cache() {
+            return cache;
+        }
+
+        std::string get_cache_dir() {
+            return cache_dir;
+        }
+
+        bool get_cache_stats() {
+            return cache_stats;
+        }
+
+        bool get_stats() {
+            return stats;
+        }
+
+        bool get_time_phases() {
+            return time_phases;
+        }
+
+        bool get_json() {
+            return json;
+        }
+
         void print_usage(int);
 };
 
@@ -3,34 +3,52 @@
 /*
  *  Utility functions for outputting error messages.
  *
- *  All error functions exit the program after printing the error message. 
+ *  Syntax and semantic errors are thrown until the driver reports them,
+ *  which prints the error message and exits the program.
  */
 
-void parser_error(Tokenstream& ts, Token* token) {
+void parser_error(Tokenstream& ts, const Token* token) {
+    // stop the lexer before reporting, the token stays valid
+    ts.close();
+
     // make error messages similar to Flex/Bison
     // for compatibility with the Stanford grading tests
+    std::ostringstream message;
     if (token == nullptr) {
         // handle special case where token is EOF
-        std::cout << "Line " << ts.get_line_number() << ": ";
-        std::cout << "syntax error at or near EOF" << std::endl;
+        message << SourceMap::location(ts.get_line_number()) << ": ";
+        message << "syntax error at or near EOF" << std::endl;
     } else {
-        std::cout << "Line " << token->get_line_number() << ": ";
-        std::cout << "syntax error at or near ";
-        token->display();
+        message << SourceMap::location(token->get_line_number()) << ": ";
+        message << "syntax error at or near ";
+        ts.display(message, *token);
     }
 
+    throw ParseError(message.str());
+}
+
+void line_number_error(uint line, uint max_line) {
+    // the syntax tree cannot tell the lines apart beyond this point
+    throw ParseError(SourceMap::location(line) + ": program has more than "
+                     + std::to_string(max_line) + " lines in total\n");
+}
+
+void report_parse_error(const ParseError& error) {
+    std::cout << error.what();
     std::cout << "Compilation halted due to lex and parse errors" << std::endl;
     exit(1);
 }
 
 void semant_error(const std::string& msg, int line_no) {
-    std::cout << "Line " << line_no << ": " << msg << std::endl;
-    std::cout << "Compilation halted due to static semantic errors." << std::endl;
-    exit(1);
+    throw SemantError(SourceMap::location(line_no) + ": " + msg + "\n");
 }
 
 void semant_error(const std::string& msg) {
-    std::cout << msg << std::endl;
+    throw SemantError(msg + "\n");
+}
+
+void report_semant_error(const SemantError& error) {
+    std::cout << error.what();
     std::cout << "Compilation halted due to static semantic errors." << std::endl;
     exit(1);
 }
\ No newline at end of file
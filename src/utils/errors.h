@@ -2,12 +2,34 @@
 #define ERRORS_H
 
 #include <string>
+#include <sstream>
 #include <iostream>
+#include <stdexcept>
+#include "source_file.h"
 #include "../common/token.h"
 
-void parser_error(Tokenstream&, Token*);
+// a syntax error, raised by parser_error. the driver reports it and halts,
+// but only after the files before it have been parsed, so that the error
+// of the first file is reported when several files are parsed at once
+class ParseError : public std::runtime_error {
+    public:
+        using std::runtime_error::runtime_error;
+};
 
-void semant_error(const std::string&, int);
-void semant_error(const std::string&);
+// a semantic error, raised by semant_error. it is reported by the driver
+// as well, so that classes can be checked in parallel and the error of the
+// first class is reported, as if they were checked in order
+class SemantError : public std::runtime_error {
+    public:
+        using std::runtime_error::runtime_error;
+};
 
-#endif
\ No newline at end of file
+void parser_error(Tokenstream&, const Token*);
+[[noreturn]] void line_number_error(uint, uint);
+[[noreturn]] void report_parse_error(const ParseError&);
+
+[[noreturn]] void semant_error(const std::string&, int);
+[[noreturn]] void semant_error(const std::string&);
+[[noreturn]] void report_semant_error(const SemantError&);
+
+#endif
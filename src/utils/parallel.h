@@ -0,0 +1,48 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+/*
+ *  Runs task(i) for every i below count on up to jobs threads, including the
+ *  calling thread. Indices are handed out in increasing order as threads
+ *  become free, so a few large tasks do not hold up the rest.
+ */
+
+// number of threads parallel_for runs count tasks on
+inline uint parallel_workers(size_t count, uint jobs) {
+    return std::max<size_t>(1, std::min<size_t>(jobs, count));
+}
+
+// like parallel_for, but the task also gets the number of the thread
+// running it, below parallel_workers(count, jobs), to keep state per thread
+template <typename F>
+void parallel_for_workers(size_t count, uint jobs, F&& task) {
+    std::atomic<size_t> next{0};
+
+    auto work = [&](uint worker) {
+        for (size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < count;) {
+            task(worker, i);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (uint worker = 1; worker < parallel_workers(count, jobs); ++worker) {
+        workers.emplace_back(work, worker);
+    }
+    work(0);
+
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+template <typename F>
+void parallel_for(size_t count, uint jobs, F&& task) {
+    parallel_for_workers(count, jobs, [&](uint, size_t i) { task(i); });
+}
+
+#endif
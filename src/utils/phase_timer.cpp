@@ -0,0 +1,50 @@
+#include "phase_timer.h"
+
+/*
+ *  Timing of the compiler phases.
+ */
+
+std::array<PhaseTimer::Times, static_cast<size_t>(Phase::Count)> PhaseTimer::totals;
+
+PhaseTimer::PhaseTimer(Phase phase) : phase(phase), wall_start(std::chrono::steady_clock::now()), cpu_start(cpu_time()) {}
+
+PhaseTimer::~PhaseTimer() {
+    Times& times = totals[static_cast<size_t>(phase)];
+    times.wall_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - wall_start).count();
+    times.cpu_ns += cpu_time() - cpu_start;
+}
+
+uint64_t PhaseTimer::cpu_time() {
+    timespec now;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &now);
+    return uint64_t(now.tv_sec) * 1000000000 + now.tv_nsec;
+}
+
+const char* PhaseTimer::get_phase_name(Phase phase) {
+    switch (phase) {
+        case Phase::Read: return "read";
+        case Phase::Scan: return "scan";
+        case Phase::Parse: return "parse";
+        case Phase::ClassTable: return "classtable";
+        case Phase::Typecheck: return "typecheck";
+        case Phase::Layout: return "layout";
+        case Phase::Prototypes: return "prototypes";
+        case Phase::Methods: return "methods";
+        case Phase::Output: return "output";
+        default: return "unknown";
+    }
+}
+
+void PhaseTimer::write_json(Writer& out) {
+    Times total;
+
+    out << "{\"phases\":{";
+    for (size_t i = 0; i < totals.size(); ++i) {
+        const Times& times = totals[i];
+        out << (i > 0 ? "," : "") << '"' << get_phase_name(static_cast<Phase>(i)) << "\":{\"wall_us\":"
+            << times.wall_ns / 1000 << ",\"cpu_us\":" << times.cpu_ns / 1000 << '}';
+        total.wall_ns += times.wall_ns;
+        total.cpu_ns += times.cpu_ns;
+    }
+    out << "},\"total\":{\"wall_us\":" << total.wall_ns / 1000 << ",\"cpu_us\":" << total.cpu_ns / 1000 << "}}\n";
+}
@@ -0,0 +1,61 @@
+#ifndef PHASE_TIMER_H
+#define PHASE_TIMER_H
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include "writer.h"
+
+/*
+ *  Wall and CPU time spent in each phase of the compiler, for --time-phases.
+ *
+ *  A PhaseTimer adds the time from its construction to its destruction to
+ *  the total of its phase, so a phase that runs several times, once per file
+ *  or once per class, adds up. CPU time is that of the whole process, so it
+ *  includes the worker threads and may exceed the wall time. When lexing
+ *  on demand, the scanning happens while parsing and is counted as such.
+ */
+
+enum class Phase {
+    Read,
+    Scan,
+    Parse,
+    ClassTable,
+    Typecheck,
+    Layout,
+    Prototypes,
+    Methods,
+    Output,
+    Count
+};
+
+class PhaseTimer {
+    private:
+        struct Times {
+            uint64_t wall_ns = 0;
+            uint64_t cpu_ns = 0;
+        };
+
+        static std::array<Times, static_cast<size_t>(Phase::Count)> totals;
+
+        Phase phase;
+        std::chrono::steady_clock::time_point wall_start;
+        uint64_t cpu_start;
+
+        static uint64_t cpu_time();
+
+    public:
+        explicit PhaseTimer(Phase);
+        ~PhaseTimer();
+
+        PhaseTimer(const PhaseTimer&) = delete;
+        PhaseTimer& operator=(const PhaseTimer&) = delete;
+
+        static const char* get_phase_name(Phase);
+
+        // a single JSON object with the times of every phase in microseconds
+        static void write_json(Writer&);
+};
+
+#endif
@@ -4,49 +4,79 @@
  *  Utilities for escaping special characters in strings, used for formatting output.
  */
 
-std::string get_escaped_string(const std::string& value) {
-    std::ostringstream pretty_value;
+std::string get_numeric_escape(char c) {
+    // the character code in decimal, padded to three digits
+    std::string digits = std::to_string(uint(c));
+    return "\\" + std::string(digits.size() < 3 ? 3 - digits.size() : 0, '0') + digits;
+}
+
+std::string get_escaped_string(std::string_view value) {
+    std::string pretty_value;
+    pretty_value.reserve(value.size());
 
     for (char c : value) {
         switch (c) {
             case '\n':
-                pretty_value << "\\n";
+                pretty_value += "\\n";
                 break;
             case '\r':
-                pretty_value << "\\015";
+                pretty_value += "\\015";
                 break;
             case '\x1b':
-                pretty_value << "\\033";
+                pretty_value += "\\033";
                 break;
             case '\t':
-                pretty_value << "\\t";
+                pretty_value += "\\t";
                 break;
             case '\b':
-                pretty_value << "\\b";
+                pretty_value += "\\b";
                 break;
             case '\f':
-                pretty_value << "\\f";
+                pretty_value += "\\f";
                 break;
             case '"':
-                pretty_value << "\\\"";
+                pretty_value += "\\\"";
                 break;
             case '\\':
-                pretty_value << "\\\\";
+                pretty_value += "\\\\";
                 break;
             default:
                 if (std::isprint(c)) {
-                    pretty_value << c;
+                    pretty_value += c;
                 } else {
-                    pretty_value << "\\" << std::setw(3) << std::setfill('0') << uint(c);
+                    pretty_value += get_numeric_escape(c);
                 }
                 break;
         }
     }
 
-    return pretty_value.str();
+    return pretty_value;
 }
 
-std::string get_pretty_string(const std::string& value) {
+std::string get_pretty_string(std::string_view value) {
     // print so it makes the Stanford grading tests happy  
     return '"' + get_escaped_string(value) + '"';
-}
\ No newline at end of file
+}
+
+std::string get_json_string(std::string_view value) {
+    // bytes outside of printable ASCII are written as \u escapes, so the
+    // output is valid JSON whatever the encoding of the source
+    static const char hex[] = "0123456789abcdef";
+    std::string json = "\"";
+
+    for (char c : value) {
+        unsigned char byte = c;
+        if (c == '"' || c == '\\') {
+            json += '\\';
+            json += c;
+        } else if (byte >= 0x20 && byte < 0x7f) {
+            json += c;
+        } else {
+            json += "\\u00";
+            json += hex[byte >> 4];
+            json += hex[byte & 0xf];
+        }
+    }
+
+    return json + '"';
+}
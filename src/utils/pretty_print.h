@@ -3,8 +3,11 @@
 
 #include <sstream>
 #include <iomanip>
+#include <string_view>
 
-std::string get_pretty_string(const std::string&);
-std::string get_escaped_string(const std::string&);
+std::string get_pretty_string(std::string_view);
+std::string get_escaped_string(std::string_view);
+std::string get_numeric_escape(char);
+std::string get_json_string(std::string_view);
 
 #endif
\ No newline at end of file
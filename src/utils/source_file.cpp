@@ -0,0 +1,88 @@
+#include "source_file.h"
+
+/*
+ *  Read-only view of a source file.
+ *
+ *  Regular files are memory-mapped, so the contents are never copied;
+ *  tokens refer directly into the mapping for as long as the SourceFile lives.
+ */
+
+SourceFile::SourceFile(const std::string& filename) : name(filename) {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Invalid file.");
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+        size = st.st_size;
+
+        if (size == 0) {
+            // mmap does not accept empty mappings
+            data = "";
+            close(fd);
+            return;
+        }
+
+        void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping != MAP_FAILED) {
+            madvise(mapping, size, MADV_SEQUENTIAL);
+            data = static_cast<const char*>(mapping);
+            mapped = true;
+            close(fd);
+            return;
+        }
+    }
+
+    close(fd);
+
+    // fall back to reading the file into memory
+    std::ifstream t_file(filename, std::ios::binary);
+    if (!t_file) {
+        throw std::runtime_error("Invalid file.");
+    }
+
+    std::ostringstream buffer;
+    buffer << t_file.rdbuf();
+    fallback_buffer = buffer.str();
+
+    data = fallback_buffer.data();
+    size = fallback_buffer.size();
+}
+
+SourceFile::~SourceFile() {
+    if (mapped) {
+        munmap(const_cast<char*>(data), size);
+    }
+}
+
+const SourceMap::File* SourceMap::find(uint line) {
+    // the last file whose lines start before the given one
+    auto it = std::upper_bound(files.begin(), files.end(), line, [](uint l, const File& file) {
+        return l <= file.first_line;
+    });
+    return it == files.begin() ? nullptr : &*std::prev(it);
+}
+
+uint SourceMap::add_file(const SourceFile& source) {
+    std::string_view contents = source.get_contents();
+    uint first_line = next_line;
+
+    files.push_back({ source.get_name(), first_line });
+    next_line += 1 + std::count(contents.begin(), contents.end(), '\n');
+
+    return first_line;
+}
+
+std::string SourceMap::location(uint line) {
+    if (files.size() < 2) {
+        return "Line " + std::to_string(line);
+    }
+
+    const File* file = find(line);
+    if (!file) {
+        return "Line " + std::to_string(line);
+    }
+
+    return file->name + ": Line " + std::to_string(line - file->first_line);
+}
@@ -0,0 +1,77 @@
+#ifndef SOURCE_FILE_H
+#define SOURCE_FILE_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <fstream>
+#include <sstream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+class SourceFile {
+    private:
+        std::string name;
+        const char* data = nullptr;
+        size_t size = 0;
+        bool mapped = false;
+
+        // only used when the file cannot be memory-mapped (e.g. pipes)
+        std::string fallback_buffer;
+
+    public:
+        SourceFile(const std::string&);
+        ~SourceFile();
+
+        SourceFile(const SourceFile&) = delete;
+        SourceFile& operator=(const SourceFile&) = delete;
+
+        const std::string& get_name() const {
+            return name;
+        }
+
+        std::string_view get_contents() const {
+            return std::string_view(data, size);
+        }
+};
+
+// when several files are compiled together, the line numbers of each file
+// continue where those of the previous file ended, so that every line in the
+// program has a unique number. the source map turns them back into the file
+// and the line within the file for diagnostics and dumps
+class SourceMap {
+    private:
+        struct File {
+            std::string name;
+
+            // the lines of the file are numbered from first_line + 1
+            uint first_line;
+        };
+
+        static inline std::vector<File> files;
+        static inline uint next_line = 0;
+
+        static const File* find(uint line);
+
+    public:
+        // registers the next file, returns the offset of its line numbers
+        static uint add_file(const SourceFile&);
+
+        static uint local_line(uint line) {
+            // a single file keeps its own line numbers
+            if (files.size() < 2) {
+                return line;
+            }
+            const File* file = find(line);
+            return file ? line - file->first_line : line;
+        }
+
+        // "Line <n>", preceded by the name of the file when there are several
+        static std::string location(uint line);
+};
+
+#endif
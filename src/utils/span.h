@@ -0,0 +1,59 @@
+#ifndef SPAN_H
+#define SPAN_H
+
+#include <cstddef>
+#include <iterator>
+
+/*
+ *  Non-owning view of a contiguous array, for handing out
+ *  parts of a table without copying them.
+ */
+
+template <typename T>
+class Span {
+    private:
+        const T* items = nullptr;
+        size_t count = 0;
+
+    public:
+        Span() = default;
+        Span(const T* first, size_t n) : items(first), count(n) {}
+
+        const T* begin() const {
+            return items;
+        }
+
+        const T* end() const {
+            return items + count;
+        }
+
+        std::reverse_iterator<const T*> rbegin() const {
+            return std::reverse_iterator<const T*>(end());
+        }
+
+        std::reverse_iterator<const T*> rend() const {
+            return std::reverse_iterator<const T*>(begin());
+        }
+
+        size_t size() const {
+            return count;
+        }
+
+        bool empty() const {
+            return count == 0;
+        }
+
+        const T& operator[](size_t i) const {
+            return items[i];
+        }
+
+        const T& front() const {
+            return items[0];
+        }
+
+        const T& back() const {
+            return items[count - 1];
+        }
+};
+
+#endif
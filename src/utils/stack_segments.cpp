@@ -0,0 +1,48 @@
+#include "stack_segments.h"
+
+/*
+ *  Each stack segment is the stack of a short-lived thread. The calling
+ *  thread blocks until the segment returns, so the recursion still runs
+ *  sequentially and needs no synchronization.
+ */
+
+struct Segment {
+    void (*function)(void*);
+    void* argument;
+
+    // an exception cannot leave the thread, so it is
+    // rethrown in the calling thread after the join
+    std::exception_ptr exception;
+};
+
+static void* run_segment(void* arg) {
+    Segment* segment = static_cast<Segment*>(arg);
+    try {
+        segment->function(segment->argument);
+    } catch (...) {
+        segment->exception = std::current_exception();
+    }
+    return nullptr;
+}
+
+void StackSegments::run_on_new_segment(void (*function)(void*), void* argument) {
+    Segment segment = { function, argument, nullptr };
+
+    pthread_attr_t attributes;
+    pthread_attr_init(&attributes);
+    pthread_attr_setstacksize(&attributes, Constants::StackSegmentReserve + segment_depth * Constants::StackBytesPerLevel);
+
+    pthread_t thread;
+    int error = pthread_create(&thread, &attributes, run_segment, &segment);
+    pthread_attr_destroy(&attributes);
+
+    if (error != 0) {
+        throw std::runtime_error("Unable to allocate a stack segment.");
+    }
+
+    pthread_join(thread, nullptr);
+
+    if (segment.exception) {
+        std::rethrow_exception(segment.exception);
+    }
+}
@@ -0,0 +1,65 @@
+#ifndef STACK_SEGMENTS_H
+#define STACK_SEGMENTS_H
+
+#include <pthread.h>
+#include <stdexcept>
+#include <exception>
+#include <type_traits>
+#include "../common/consts.h"
+
+/*
+ *  Stack segments for deep recursion.
+ *
+ *  The parser, the type checker and the code generator recurse once for
+ *  every level of nesting in the program. Each of them wraps the recursive
+ *  step in StackSegments::nested, which counts the levels of nesting on the
+ *  current stack. Once the count reaches the segment depth, the recursion
+ *  continues on a new, heap-allocated stack, so the nesting of a program is
+ *  only limited by the available memory.
+ */
+
+class StackSegments {
+    private:
+        // number of nested calls on each segment before switching to a new one
+        static inline uint segment_depth = Constants::StackSegmentDepth;
+
+        // number of nested calls on the segment of the current thread
+        static inline thread_local uint depth = 0;
+
+        struct Level {
+            Level() { ++depth; }
+            ~Level() { --depth; }
+        };
+
+        template <typename F>
+        static void call(void* f) {
+            (*static_cast<F*>(f))();
+        }
+
+        // runs the function on a new stack and waits for it to return
+        static void run_on_new_segment(void (*)(void*), void*);
+
+    public:
+        static void set_segment_depth(uint d) {
+            segment_depth = d;
+        }
+
+        template <typename F>
+        static auto nested(F&& f) -> decltype(f()) {
+            if (depth < segment_depth) {
+                Level level;
+                return f();
+            }
+
+            if constexpr (std::is_void_v<decltype(f())>) {
+                run_on_new_segment(&call<std::remove_reference_t<F>>, &f);
+            } else {
+                decltype(f()) result{};
+                auto task = [&] { result = f(); };
+                run_on_new_segment(&call<decltype(task)>, &task);
+                return result;
+            }
+        }
+};
+
+#endif
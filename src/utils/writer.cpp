@@ -0,0 +1,30 @@
+#include "writer.h"
+
+/*
+ *  Buffered writer for the dumps of tokens and syntax trees.
+ */
+
+Writer& Writer::standard_output() {
+    static Writer writer(STDOUT_FILENO);
+    return writer;
+}
+
+void Writer::write_all(const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t written = ::write(fd, data, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            // nothing sensible can be done if the output is gone, e.g. a closed pipe
+            return;
+        }
+        data += written;
+        size -= written;
+    }
+}
+
+void Writer::flush() {
+    write_all(buffer.data(), buffer.size());
+    buffer.clear();
+}
@@ -0,0 +1,95 @@
+#ifndef WRITER_H
+#define WRITER_H
+
+#include <string>
+#include <string_view>
+#include <charconv>
+#include <type_traits>
+#include <cerrno>
+#include <unistd.h>
+
+/*
+ *  Buffered output for the dumps of tokens and syntax trees.
+ *
+ *  Output is collected in a buffer and written to the file descriptor in
+ *  large chunks, rather than flushing on every line like std::endl does.
+ *  The buffer is flushed when it fills up and when the writer is destroyed,
+ *  which for standard output happens when the program exits.
+ */
+
+class Writer {
+    private:
+        int fd;
+        std::string buffer;
+
+        void write_all(const char*, size_t);
+
+    public:
+        static constexpr size_t BufferSize = 64 * 1024;
+
+        explicit Writer(int fd) : fd(fd) {
+            buffer.reserve(BufferSize);
+        }
+
+        ~Writer() {
+            flush();
+        }
+
+        Writer(const Writer&) = delete;
+        Writer& operator=(const Writer&) = delete;
+
+        // the writer for standard output, shared by all dumps
+        static Writer& standard_output();
+
+        void flush();
+
+        Writer& operator<<(std::string_view text) {
+            if (buffer.size() + text.size() > BufferSize) {
+                flush();
+            }
+            if (text.size() > BufferSize) {
+                write_all(text.data(), text.size());
+            } else {
+                buffer.append(text);
+            }
+            return *this;
+        }
+
+        Writer& operator<<(const char* text) {
+            return *this << std::string_view(text);
+        }
+
+        Writer& operator<<(const std::string& text) {
+            return *this << std::string_view(text);
+        }
+
+        Writer& operator<<(char c) {
+            if (buffer.size() == BufferSize) {
+                flush();
+            }
+            buffer.push_back(c);
+            return *this;
+        }
+
+        // written as 1 or 0, like an std::ostream does
+        Writer& operator<<(bool value) {
+            return *this << (value ? '1' : '0');
+        }
+
+        template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+        Writer& operator<<(T value) {
+            char digits[24];
+            std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+            return *this << std::string_view(digits, result.ptr - digits);
+        }
+
+        Writer& indent(uint spaces) {
+            if (buffer.size() + spaces > BufferSize) {
+                flush();
+            }
+            buffer.append(spaces, ' ');
+            return *this;
+        }
+};
+
+#endif
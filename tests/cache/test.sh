@@ -0,0 +1,84 @@
+#!/bin/bash
+
+# compiles the programs of the code generation tests with and without the
+# AST cache. a program compiled from the cache, with or without its types,
+# has to give the same dumps and code as one compiled from the source, and
+# damaged or outdated cache entries have to be ignored
+
+output_dirname="test-output"
+coolr="../../../coolr"
+
+cd ../cgen/grading || exit 1
+output_dirname="../../cache/${output_dirname}"
+mkdir -p ${output_dirname} || exit 1
+
+num_correct_tests=0
+num_total_tests=0
+
+# runs the compiler with the cache and compares its output and cache statistics
+# with the expected ones; usage: check <name> <flag> <expected stats>
+check() {
+    local name=$1 flag=$2 stats=$3
+
+    if [ "$flag" = "--cgen" ]; then
+        $coolr "$file" --cache-dir "$cache_dir" --cache-stats --out "${output_dirname}/${filename}_${name}.S" > /dev/null 2> "${output_dirname}/${filename}_${name}_stats.txt"
+        # labels are named after the addresses of the nodes, which differ between runs
+        diff <(sed 's/_0x[0-9a-f]*/_0x/g' "${output_dirname}/${filename}_${name}.S") <(sed 's/_0x[0-9a-f]*/_0x/g' "${output_dirname}/${filename}.S") > /dev/null || failed="$failed $name"
+    else
+        $coolr "$file" $flag --cache-dir "$cache_dir" --cache-stats > "${output_dirname}/${filename}_${name}.txt" 2> "${output_dirname}/${filename}_${name}_stats.txt"
+        diff "${output_dirname}/${filename}_${name}.txt" "${output_dirname}/${filename}${flag}.txt" > /dev/null || failed="$failed $name"
+    fi
+
+    [ "$(cat "${output_dirname}/${filename}_${name}_stats.txt")" = "AST cache: $stats" ] || failed="$failed $name-stats"
+}
+
+for file in *.cl; do
+    filename=$(basename "$file" .cl)
+    cache_dir="${output_dirname}/${filename}_cache"
+    failed=""
+
+    echo -n "Performing test $filename... ";
+
+    rm -rf "$cache_dir"
+    $coolr "$file" --parse > "${output_dirname}/${filename}--parse.txt"
+    $coolr "$file" --semant > "${output_dirname}/${filename}--semant.txt"
+    $coolr "$file" --out "${output_dirname}/${filename}.S"
+
+    # the first compilation fills the cache, the analysis adds the types
+    check miss --semant "0 hits (0 with types), 1 misses"
+    check hit --semant "1 hits (1 with types), 0 misses"
+    check parse-hit --parse "1 hits (0 with types), 0 misses"
+    check cgen-hit --cgen "1 hits (1 with types), 0 misses"
+
+    entry=$(ls "$cache_dir"/*.coolast)
+
+    # a truncated entry is rebuilt from the source
+    truncate -s $(($(wc -c < "$entry") / 2)) "$entry"
+    check truncated --semant "0 hits (0 with types), 1 misses"
+
+    # so is one whose contents no longer match the checksum
+    printf '\377' | dd of="$entry" bs=1 seek=$(($(wc -c < "$entry") - 1)) conv=notrunc status=none
+    check damaged --parse "0 hits (0 with types), 1 misses"
+
+    # and one written in another version of the format
+    printf '\377' | dd of="$entry" bs=1 seek=8 conv=notrunc status=none
+    check version --semant "0 hits (0 with types), 1 misses"
+    check rebuilt --semant "1 hits (1 with types), 0 misses"
+
+    # --no-cache bypasses the cache even when a directory is given
+    rm -rf "$cache_dir"
+    $coolr "$file" --semant --cache-dir "$cache_dir" --no-cache --cache-stats > "${output_dirname}/${filename}_no-cache.txt" 2> "${output_dirname}/${filename}_no-cache_stats.txt"
+    diff "${output_dirname}/${filename}_no-cache.txt" "${output_dirname}/${filename}--semant.txt" > /dev/null || failed="$failed no-cache"
+    [ ! -s "${output_dirname}/${filename}_no-cache_stats.txt" ] && [ ! -e "$cache_dir" ] || failed="$failed no-cache-stats"
+
+    if [ -z "$failed" ]; then
+        ((num_correct_tests++))
+        echo "Passed!"
+    else
+        echo "Failed:$failed."
+    fi
+
+    ((num_total_tests++))
+done
+
+printf "\nPassed %s of %s tests.\n" "$num_correct_tests" "$num_total_tests"
@@ -0,0 +1,53 @@
+-- An attribute can have the same name as a method of its class,
+-- and reading the attribute must not read some other slot of the object.
+
+class Counter inherits IO
+{
+  first : Int <- 1;
+  count : Int <- 42;
+  label : String <- "count";
+
+  first() : Int { 100 };
+  label() : String { "label" };
+  count() : Int { count + 1 };
+
+  bump() : SELF_TYPE
+  {
+    {
+      count <- count + 10;
+      self;
+    }
+  };
+
+  print() : Object
+  {
+    {
+      out_int( first );
+      out_string( " " );
+      out_int( count );
+      out_string( " " );
+      out_string( label );
+      out_string( "\n" );
+    }
+  };
+};
+
+class Main inherits IO
+{
+  main() : Object
+  {
+    let counter : Counter <- new Counter in
+      {
+	out_int( counter.count() );
+	out_string( "\n" );
+	counter.bump();
+	out_int( counter.count() );
+	out_string( "\n" );
+	out_int( counter.first() );
+	out_string( "\n" );
+	out_string( counter.label() );
+	out_string( "\n" );
+	counter.print();
+      }
+  };
+};
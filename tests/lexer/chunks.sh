@@ -0,0 +1,46 @@
+#!/bin/bash
+
+# large programs are lexed in parallel chunks, which has to give the same
+# tokens as lexing them in one piece. the programs in chunks/ are repeated
+# until they span several chunks, so strings and comments cross the chunk
+# boundaries at different places for each number of jobs
+
+output_dirname="test-output"
+min_size=$((2 * 1024 * 1024))
+
+cd chunks && mkdir -p ${output_dirname} || exit 1
+
+num_correct_tests=0
+num_total_tests=0
+
+for file in *.cool; do
+    filename=$(basename "$file" .cool)
+    program="${output_dirname}/${filename}_large.cool"
+
+    : > "$program"
+    while [ "$(wc -c < "$program")" -lt "$min_size" ]; do
+        cat "$file" "$file" "$file" "$file" "$file" "$file" "$file" "$file" >> "$program"
+    done
+
+    ../../../coolr "$program" --lex --jobs 1 > "${output_dirname}/${filename}_expected.txt"
+
+    for jobs in 2 3 4 5 7 8; do
+        echo -n "Performing test $filename with $jobs jobs... ";
+
+        ../../../coolr "$program" --lex --jobs $jobs > "${output_dirname}/${filename}_${jobs}_result.txt"
+
+        diff "${output_dirname}/${filename}_${jobs}_result.txt" "${output_dirname}/${filename}_expected.txt" > "${output_dirname}/${filename}_${jobs}_diff.txt"
+
+        num_lines=$(wc -l < "${output_dirname}/${filename}_${jobs}_diff.txt")
+        if [ "$num_lines" -eq 0 ]; then
+            ((num_correct_tests++))
+            echo "Passed!"
+        else
+            echo "Failed."
+        fi
+
+        ((num_total_tests++))
+    done
+done
+
+printf "\nPassed %s of %s tests.\n" "$num_correct_tests" "$num_total_tests"
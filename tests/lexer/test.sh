@@ -27,4 +27,25 @@ for file in *.cool; do
     ((num_total_tests++))
 done
 
+# the same dumps as JSON lines, for the tests that have them
+for file in *.cool.json.out; do
+    filename=$(basename "$file" .cool.json.out)
+
+    echo -n "Performing test $filename (JSON)... ";
+
+    ../../../coolr "${filename}.cool" --lex --json > "${output_dirname}/${filename}_json_result.txt"
+
+    diff "${output_dirname}/${filename}_json_result.txt" "$file" > "${output_dirname}/${filename}_json_diff.txt"
+
+    num_lines=$(wc -l < "${output_dirname}/${filename}_json_diff.txt")
+    if [ "$num_lines" -eq 0 ]; then
+        ((num_correct_tests++))
+        echo "Passed!"
+    else
+        echo "Failed."
+    fi
+
+    ((num_total_tests++))
+done
+
 printf "\nPassed %s of %s tests.\n" "$num_correct_tests" "$num_total_tests"
@@ -0,0 +1,4 @@
+class B inherits A {
+  name() : String { "B\n" };
+  broken() : Int { if 1 then 2 fi };
+};
@@ -0,0 +1,3 @@
+class A {
+  name( : String { "A\n" };
+};
@@ -0,0 +1,3 @@
+class A {
+  x : Int <- 1;
+};
@@ -0,0 +1,4 @@
+(* second file *)
+class B {
+  s : String <- "b";
+};
@@ -0,0 +1,5 @@
+class Main inherits IO {
+  main() : Object {
+    out_string(new B.name())
+  };
+};
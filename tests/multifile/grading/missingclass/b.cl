@@ -0,0 +1,3 @@
+class B inherits C {
+  name() : String { "B\n" };
+};
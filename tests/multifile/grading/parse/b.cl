@@ -0,0 +1,5 @@
+-- a comment to shift the lines
+
+class B inherits A {
+  name() : String { "B\n" };
+};
@@ -0,0 +1,5 @@
+class B inherits A {
+  name() : String { "B\n" };
+
+  broken() : Int { 1 + };
+};
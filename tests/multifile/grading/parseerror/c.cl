@@ -0,0 +1,4 @@
+class A {
+  name() : String { "A\n" };
+  count : Int <- 2;
+};
@@ -0,0 +1,5 @@
+class A {
+  name() : String { "A\n" };
+
+  count : Int <- "two";
+};
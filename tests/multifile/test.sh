@@ -0,0 +1,37 @@
+#!/bin/bash
+
+# every directory in grading/ holds the files of one program, which are
+# compiled together in alphabetical order with the options given in flags.
+# the line numbers in dumps and errors are those within each file
+
+output_dirname="test-output"
+
+cd grading && mkdir -p ${output_dirname} || exit 1
+
+num_correct_tests=0
+num_total_tests=0
+
+for dir in */; do
+    testname=$(basename "$dir")
+    if [ "$testname" = "${output_dirname}" ]; then
+        continue
+    fi
+
+    echo -n "Performing test $testname... ";
+
+    (cd "$dir" && ../../../../coolr *.cl $(cat flags)) > "${output_dirname}/${testname}_result.txt"
+
+    diff "${output_dirname}/${testname}_result.txt" "${testname}.out" > "${output_dirname}/${testname}_diff.txt"
+
+    num_lines=$(wc -l < "${output_dirname}/${testname}_diff.txt")
+    if [ "$num_lines" -eq 0 ]; then
+        ((num_correct_tests++))
+        echo "Passed!"
+    else
+        echo "Failed."
+    fi
+
+    ((num_total_tests++))
+done
+
+printf "\nPassed %s of %s tests.\n" "$num_correct_tests" "$num_total_tests"
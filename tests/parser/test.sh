@@ -29,4 +29,25 @@ for file in *.test; do
     ((num_total_tests++))
 done
 
+# the same dumps as JSON lines, for the tests that have them
+for file in *.test.json.out; do
+    filename=$(basename "$file" .test.json.out)
+
+    echo -n "Performing test $filename (JSON)... ";
+
+    ../../../coolr "${filename}.test" --parse --json > "${output_dirname}/${filename}_json_result.txt"
+
+    diff "${output_dirname}/${filename}_json_result.txt" "$file" > "${output_dirname}/${filename}_json_diff.txt"
+
+    num_lines=$(wc -l < "${output_dirname}/${filename}_json_diff.txt")
+    if [ "$num_lines" -eq 0 ]; then
+        ((num_correct_tests++))
+        echo "Passed!"
+    else
+        echo "Failed."
+    fi
+
+    ((num_total_tests++))
+done
+
 printf "\nPassed %s of %s tests.\n" "$num_correct_tests" "$num_total_tests"